@@ -0,0 +1,64 @@
+#pragma once
+#include <string>
+#include "graph.h"
+#include "floyd_warshall.h"
+
+///@brief the engines AutoStrategy can dispatch to
+enum class AutoChoice {
+    Sequential,
+    ParallelDijkstra,
+    BlockedFloydWarshall
+};
+
+///@return printable name of the engine
+const char* autoChoiceName(AutoChoice choice);
+
+///@brief the engine chosen by AutoStrategy together with the explanation
+struct AutoDecision {
+    AutoChoice choice = AutoChoice::Sequential;
+    std::string reason;
+    double floyd_ns = 0;    // оцінка часу Флойда-Воршелла на одному потоці
+    double johnson_ns = 0;  // оцінка часу Джонсона на одному потоці
+};
+
+///@brief strategy which picks the fastest engine for the given graph and hardware
+///
+/// The choice is made on every execute() from V, E, the reach of the vertices sampled by breadth-first
+/// search from a few sources and the number of threads. Johnson's algorithm and Floyd-Warshall are compared
+/// by a cost model whose constants were fitted to Benchmark::benchmarkAutoStrategy timings, small inputs
+/// stay on the calling thread because splitting them costs more than it saves.
+/// The chosen engine and the reason are written to std::clog and kept in getLastDecision().
+class AutoStrategy : public PooledStrategy {
+private:
+    std::unique_ptr<SequentialStrategy> sequential;
+    std::unique_ptr<ParallelDijkstraStrategy> parallel;
+    std::unique_ptr<BlockedFloydWarshallStrategy> floyd;
+    AutoDecision last_decision;
+    bool logging = true;
+
+public:
+    ///@brief constructor of the class which set thread count, 0 means hardware_concurrency()
+    AutoStrategy(size_t threads = 0);
+    ///@brief constructor which uses an externally owned long-lived pool
+    explicit AutoStrategy(std::shared_ptr<ThreadPool> sharedPool);
+
+    /**
+     * @brief choosing the engine without running it
+     *
+     * Besides reading the graph it runs breadth-first search from at most 16 sources, O(16 * (V + E))
+     * @param graph the graph to be processed
+     * @param threads the number of threads available to the engine
+     * @return the engine and the reason of the choice
+     */
+    static AutoDecision choose(const Graph& graph, size_t threads);
+
+    ///@return the decision made by the last execute()
+    const AutoDecision& getLastDecision() const { return last_decision; }
+    ///@brief switching the log of the decisions to std::clog on or off
+    void setLogging(bool enabled) { logging = enabled; }
+    void execute(Graph& graph, DistanceMatrix& dist) override;
+    ///@brief running the sources one by one or in parallel depending on their number and the threads
+    void executeSources(Graph& graph, const std::vector<int>& sources, DistanceMatrix& dist) override;
+    ///@brief computing the rows by Dijkstra, Floyd-Warshall is never chosen because it needs the whole matrix
+    void executeToSink(Graph& graph, RowSink& sink) override;
+};
@@ -0,0 +1,33 @@
+#pragma once
+#include <vector>
+#include "csr_graph.h"
+#include "thread_pool.h"
+
+/**
+ * @brief queue-based Bellman-Ford (SPFA) with subtree disassembly
+ *
+ * Every vertex with a finite distance starts in the queue as a child of a virtual root. Only the edges of
+ * vertices whose distance changed are relaxed. When dist[v] decreases, the subtree of v in the tree of
+ * shortest paths is removed: its distances are built on the old value of dist[v] and will be improved
+ * again through v, so they are not scanned meanwhile. Finding u inside the subtree of v means
+ * the parent pointers have closed a cycle of negative weight, which is reported at once.
+ * @param g the graph
+ * @param dist the initial distances, INF for vertices which are not sources, is used by reference
+ * @return false if a negative cycle is reachable from the sources
+ */
+bool queueBellmanFord(const CSRGraph& g, std::vector<double>& dist);
+
+/**
+ * @brief Bellman-Ford in synchronous rounds spread over the thread pool
+ *
+ * Every round pulls new distances over the incoming edges from the distances of the previous round
+ * into a second buffer, so threads never write a value another thread reads. Only the vertices with
+ * a predecessor changed in the previous round are recomputed, the frontier is split between the threads
+ * in equal parts. Round k gives the shortest walks of at most k edges, therefore a change in round V
+ * means a negative cycle.
+ * @param g the graph
+ * @param dist the initial distances, INF for vertices which are not sources, is used by reference
+ * @param pool the pool which runs the rounds
+ * @return false if a negative cycle is reachable from the sources
+ */
+bool parallelBellmanFord(const CSRGraph& g, std::vector<double>& dist, ThreadPool& pool);
@@ -37,6 +37,10 @@ public:
     void benchmarkDifferentDensities();
     ///@brief benchmark which run measurement functions for complete graph of different sizes
     void benchmarkCompleteGraphs();
+    ///@brief benchmark which compares priority queues of Dijkstra on sparse and dense graphs
+    void benchmarkHeapTypes();
+    ///@brief benchmark which compares the estimates of AutoStrategy with the measured times of both engines
+    void benchmarkAutoStrategy();
     ///@brief benchmark which run measurement functions for different variations
     void runComprehensiveBenchmark();
 };
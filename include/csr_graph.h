@@ -0,0 +1,54 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+///@brief frozen compressed sparse row (CSR) representation of the graph
+///
+/// Outgoing edges of vertex u are stored contiguously in [getOffsets()[u], getOffsets()[u + 1])
+/// of the targets and weights arrays, so relaxation loops walk plain arrays instead of list nodes.
+/// The arrays are only viewed through pointers: they may live in vectors owned by the graph
+/// or directly in the pages of a memory-mapped file, the storage handle keeps them alive.
+class CSRGraph {
+private:
+    int V;
+    size_t E;
+    const size_t* offsets;  // V + 1 елементів
+    const int* targets;
+    const double* weights;
+    std::shared_ptr<const void> storage;  // власник пам'яті масивів
+
+public:
+    /**
+     * @brief constructor which takes already built arrays
+     * @param V number of vertices
+     * @param offsets array of V + 1 edge offsets
+     * @param targets destination vertex of every edge
+     * @param weights weight of every edge
+     */
+    CSRGraph(int V, std::vector<size_t> offsets, std::vector<int> targets, std::vector<double> weights);
+
+    /**
+     * @brief constructor which views arrays owned by somebody else, nothing is copied
+     * @param V number of vertices
+     * @param E number of edges
+     * @param offsets array of V + 1 edge offsets
+     * @param targets destination vertex of every edge
+     * @param weights weight of every edge
+     * @param storage the handle which keeps the arrays alive as long as the graph exists
+     */
+    CSRGraph(int V, size_t E, const size_t* offsets, const int* targets, const double* weights,
+             std::shared_ptr<const void> storage);
+
+    int getV() const { return V; }
+    size_t getEdgeCount() const { return E; }
+
+    ///@return index of the first outgoing edge of vertex u
+    size_t edgesBegin(int u) const { return offsets[u]; }
+    ///@return index after the last outgoing edge of vertex u
+    size_t edgesEnd(int u) const { return offsets[u + 1]; }
+
+    const size_t* getOffsets() const { return offsets; }
+    const int* getTargets() const { return targets; }
+    const double* getWeights() const { return weights; }
+};
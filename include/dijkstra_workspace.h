@@ -0,0 +1,96 @@
+#pragma once
+#include <memory>
+#include <vector>
+#include <variant>
+#include "csr_graph.h"
+#include "fibonacci_heap.h"
+#include "indexed_fibonacci_heap.h"
+#include "priority_queues.h"
+#include "scc.h"
+
+///@brief reusable memory for many Dijkstra runs: the heap, distances, visited marks and a scratch row
+///
+/// The memory is allocated once for the graph size and between two sources only the vertices
+/// touched by the previous run are reset. One workspace must be used by one thread at a time.
+class DijkstraWorkspace {
+private:
+    int V;
+    HeapType heap_type;
+    std::variant<std::monostate, FibonacciHeap, IndexedFibonacciHeap, DaryHeap<4>, PairingHeap, LazyBinaryHeap> heap;
+    std::vector<double> dist;        // INF для вершин, не досягнутих в останньому запуску
+    std::vector<unsigned> visited;   // номер запуску, в якому вершину оброблено
+    unsigned epoch;
+    std::vector<int> touched;        // вершини, відстань до яких змінено в останньому запуску
+    std::vector<double> scratch;
+    std::vector<unsigned> reached;   // номер запуску, в якому компоненту досягнуто
+
+    ///@brief restoring INF for the vertices touched by the previous run and starting a new epoch
+    void reset();
+
+public:
+    DijkstraWorkspace();
+
+    /**
+     * @brief allocating the memory for the graph size and heap type, does nothing if they are the same as before
+     * @param vertices number of vertices
+     * @param heap the priority queue used by the runs
+     */
+    void prepare(int vertices, HeapType heap);
+
+    /**
+     * @brief Dijkstra algorithm from src, the result stays in getDist()
+     * @param g the edges of the graph, its size must match prepare()
+     * @param weights weights aligned with the edges of g
+     * @param src the vertex for which we search the shortest paths
+     * @param lazy_insertion inserting vertices into the heap only when they are first reached
+     */
+    void run(const CSRGraph& g, const double* weights, int src, bool lazy_insertion);
+
+    /**
+     * @brief Dijkstra from src going through the strongly connected components in topological order
+     *
+     * Components which are not reached are skipped without looking at their vertices. A single-vertex
+     * component already has its final distance when its turn comes, so only its outgoing edges are relaxed
+     * with the original weights. A larger component runs Dijkstra over its inner edges with the reweighted
+     * weights, started from all its reached vertices at once with keys dist[u] - h[u].
+     * The result in getDist() is in reweighted units, as after run()
+     * @param g the edges of the graph, its size must match prepare()
+     * @param original the original weights aligned with the edges of g
+     * @param reweighted the non-negative weights w(u, v) + h[u] - h[v]
+     * @param h the potentials of the vertices
+     * @param scc the components of g
+     * @param src the vertex for which we search the shortest paths
+     */
+    void runCondensed(const CSRGraph& g, const double* original, const double* reweighted,
+                      const std::vector<double>& h, const Condensation& scc, int src);
+
+    ///@return distances of the last run, INF for unreachable vertices
+    const std::vector<double>& getDist() const { return dist; }
+    ///@return vertices reached by the last run
+    const std::vector<int>& getTouched() const { return touched; }
+    ///@return a row of V doubles free for the caller between runs
+    std::vector<double>& getScratch() { return scratch; }
+};
+
+///@brief one Dijkstra workspace for every worker of a thread pool, freed together with its owner
+///
+/// A worker uses only its own slot, so the slots need no locking. The memory of the runs stays
+/// between calls but, unlike thread_local storage, is released when the owner is destroyed.
+class WorkerWorkspaces {
+private:
+    std::vector<std::unique_ptr<DijkstraWorkspace>> slots;  // окремі виділення, щоб слоти не ділили кеш-рядки
+
+public:
+    ///@brief constructor which creates empty workspaces for the given number of workers
+    explicit WorkerWorkspaces(size_t workers);
+
+    /**
+     * @brief the workspace of a worker
+     * @param worker the index from ThreadPool::currentWorker()
+     * @param fallback the workspace of a thread outside the pool, owned by the caller
+     * @return the slot of the worker or fallback if worker is not a valid index
+     */
+    DijkstraWorkspace& get(size_t worker, DijkstraWorkspace& fallback) {
+        return worker < slots.size() ? *slots[worker] : fallback;
+    }
+};
@@ -0,0 +1,116 @@
+#pragma once
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "distance_matrix.h"
+
+///@brief header of the binary distance file, followed by rows * cols values in row-major order
+///
+/// A block of consecutive rows (a row tile) is one contiguous range of the file,
+/// so tiles are written and read with a single call.
+struct DistanceFileHeader {
+    char magic[8];           // "JDIST\0\0\0"
+    uint32_t format_version;
+    uint32_t byte_order;     // 0x01020304 у порядку байтів машини, що записала файл
+    uint64_t rows;
+    uint64_t cols;
+    uint32_t element_size;   // 8 для double, 4 для float
+    uint32_t reserved[7];    // дані починаються з 64-го байта
+};
+
+///@return the header of a file with the given size and precision
+DistanceFileHeader makeDistanceFileHeader(int rows, int cols, DistancePrecision precision);
+
+///@brief writer of a distance file which places tiles of rows at their offsets
+///
+/// The file is created with its final size, so the tiles may be written in any order and from several
+/// threads at once: on POSIX systems every tile is one pwrite() call, elsewhere the writes are serialized.
+class DistanceFileWriter {
+private:
+    std::string path;
+    int rows;
+    int cols;
+    DistancePrecision precision;
+    int fd = -1;
+    std::unique_ptr<std::ofstream> out;  // якщо pwrite недоступний
+    std::mutex out_mutex;
+
+public:
+    /**
+     * @brief constructor which creates the file and writes its header
+     * @param path the file to create or overwrite
+     * @param rows number of rows
+     * @param cols number of values in every row
+     * @param precision the type of the stored values
+     * @throws std::runtime_error if the file can not be created
+     */
+    DistanceFileWriter(const std::string& path, int rows, int cols, DistancePrecision precision);
+    ~DistanceFileWriter();
+    DistanceFileWriter(const DistanceFileWriter&) = delete;
+    DistanceFileWriter& operator=(const DistanceFileWriter&) = delete;
+
+    ///@return the number of bytes of one stored row
+    size_t getRowBytes() const;
+
+    /**
+     * @brief writing count consecutive rows starting from firstRow
+     * @param data count * getRowBytes() bytes in the stored precision
+     * @throws std::runtime_error if the write fails
+     */
+    void writeRows(int firstRow, int count, const void* data);
+
+    ///@brief closing the file, throws std::runtime_error if it could not be written completely
+    void close();
+};
+
+///@brief read-only access to a distance file which may be much larger than the memory
+///
+/// The file is memory-mapped, so only the pages which are read are loaded and the system may drop them
+/// again under memory pressure. Where mmap is not available the values are read from the file on demand.
+/// All methods may be called from several threads.
+class DistanceFile {
+private:
+    std::string path;
+    int rows = 0;
+    int cols = 0;
+    DistancePrecision precision = DistancePrecision::Double;
+    std::shared_ptr<const void> mapping;  // nullptr, якщо значення читаються з потоку
+    const unsigned char* values = nullptr;
+    mutable std::ifstream in;
+    mutable std::mutex in_mutex;
+
+    size_t elementSize() const { return precision == DistancePrecision::Float ? sizeof(float) : sizeof(double); }
+    ///@brief copying count stored values starting at element index into out as double
+    void readValues(size_t index, size_t count, double* out) const;
+
+public:
+    /**
+     * @brief opening a file written by DistanceFileWriter or BinaryFileRowSink
+     * @param path the file
+     * @throws std::runtime_error if the file can not be opened or is not a valid distance file
+     */
+    explicit DistanceFile(const std::string& path);
+
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+    DistancePrecision getPrecision() const { return precision; }
+
+    ///@return the distance from row to col
+    double at(int row, int col) const;
+
+    ///@return one row of the matrix
+    std::vector<double> readRow(int row) const;
+
+    /**
+     * @brief reading a tile of consecutive rows into a matrix
+     * @param firstRow the first row of the tile
+     * @param dist count x getCols() matrix, the values are converted to its precision
+     */
+    void readTile(int firstRow, DistanceMatrix& dist) const;
+
+    ///@return the tile of count rows starting from firstRow in the precision of the file
+    DistanceMatrix readTile(int firstRow, int count) const;
+};
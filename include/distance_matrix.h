@@ -0,0 +1,89 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+
+///@brief the type used to store the distances
+enum class DistancePrecision {
+    Double,
+    Float   // вдвічі менше пам'яті за рахунок точності
+};
+
+///@brief row-major matrix of the shortest distances stored in one aligned buffer
+///
+/// Every row starts on an aligned address: the row length is padded up to a multiple of the alignment
+/// (a cache line by default). Values are always read and written as double and converted
+/// to the storage precision.
+class DistanceMatrix {
+private:
+    ///@brief deleter for the buffer allocated with aligned operator new
+    struct AlignedDeleter {
+        size_t alignment;
+        void operator()(unsigned char* p) const;
+    };
+
+    int rows;
+    int cols;
+    DistancePrecision precision;
+    size_t alignment;
+    size_t stride;  // кількість елементів у рядку разом з вирівнюванням
+    std::unique_ptr<unsigned char[], AlignedDeleter> buffer;
+
+    size_t elementSize() const { return precision == DistancePrecision::Float ? sizeof(float) : sizeof(double); }
+
+public:
+    ///@brief read-only view of one row, allows the matrix to be used like a vector of rows
+    class Row {
+    private:
+        const DistanceMatrix* matrix;
+        int row;
+    public:
+        Row(const DistanceMatrix* matrix, int row) : matrix(matrix), row(row) {}
+        size_t size() const { return matrix->cols; }
+        double operator[](size_t col) const { return matrix->at(row, static_cast<int>(col)); }
+    };
+
+    ///@brief the cache line size used as the default row alignment
+    static const size_t CACHE_LINE = 64;
+
+    /**
+     * @brief constructor which allocates the matrix and fills it with INF
+     * @param rows number of rows
+     * @param cols number of columns
+     * @param precision storage type of the distances
+     * @param alignment alignment of every row in bytes, must be a power of two not less than alignof(double),
+     *        otherwise std::invalid_argument is thrown
+     */
+    DistanceMatrix(int rows, int cols, DistancePrecision precision = DistancePrecision::Double,
+                   size_t alignment = CACHE_LINE);
+    ///@brief constructor of an empty matrix
+    DistanceMatrix();
+
+    DistanceMatrix(DistanceMatrix&&) noexcept = default;
+    DistanceMatrix& operator=(DistanceMatrix&&) noexcept = default;
+    DistanceMatrix(const DistanceMatrix&) = delete;
+    DistanceMatrix& operator=(const DistanceMatrix&) = delete;
+
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+    DistancePrecision getPrecision() const { return precision; }
+    ///@return number of elements between the starts of two consecutive rows
+    size_t getStride() const { return stride; }
+    ///@return size of the whole buffer in bytes
+    size_t getByteSize() const { return stride * rows * elementSize(); }
+
+    ///@return number of rows, same as size() of a vector of rows
+    size_t size() const { return rows; }
+    Row operator[](size_t row) const { return Row(this, static_cast<int>(row)); }
+
+    double at(int row, int col) const;
+    void set(int row, int col, double value);
+    ///@brief copying cols values into the row with conversion to the storage precision
+    void setRow(int row, const double* values);
+    void fill(double value);
+
+    ///@return pointer to the start of the row, the type must match the precision
+    template<class T>
+    T* rowData(int row) { return reinterpret_cast<T*>(buffer.get() + row * stride * elementSize()); }
+    template<class T>
+    const T* rowData(int row) const { return reinterpret_cast<const T*>(buffer.get() + row * stride * elementSize()); }
+};
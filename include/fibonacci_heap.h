@@ -43,6 +43,9 @@ private:
 public:
     FibonacciHeap();
 
+    ///@brief constructor which reserves the node index for the expected number of vertices
+    explicit FibonacciHeap(int capacity);
+
     ~FibonacciHeap();
 
     // Перевіряємо, чи піраміда порожня
@@ -62,4 +65,7 @@ public:
 
     // Перевіряємо, чи містить піраміда вершину
     bool contains(int vertex) const ;
+
+    ///@brief removing all remaining elements
+    void clear();
 };
\ No newline at end of file
@@ -0,0 +1,21 @@
+#pragma once
+#include "graph.h"
+
+///@brief strategy which implements tiled Floyd-Warshall for dense graphs
+///
+/// The matrix is processed in square blocks which fit into the cache. For every diagonal block k the
+/// computation has three phases: the diagonal block itself, then its row and column of blocks in parallel,
+/// then all the remaining blocks in parallel. The inner min-plus loop uses AVX2 when the processor supports it
+/// and SSE2 otherwise. A negative diagonal entry at the end means a negative cycle.
+class BlockedFloydWarshallStrategy : public PooledStrategy {
+private:
+    ///@brief number of rows and columns in one block
+    int block_size = 64;
+
+public:
+    using PooledStrategy::PooledStrategy;
+    ///@brief setting the size of the block, it is rounded up to a multiple of 8
+    void setBlockSize(int size);
+    int getBlockSize() const { return block_size; }
+    void execute(Graph& graph, DistanceMatrix& dist) override;
+};
@@ -1,11 +1,19 @@
 #pragma once
 
 #include <vector>
-#include <list>
 #include <limits>
 #include <memory>
 #include <mutex>
+#include <cstdint>
+#include <string>
+#include "csr_graph.h"
+#include "distance_matrix.h"
 #include "fibonacci_heap.h"
+#include "indexed_fibonacci_heap.h"
+#include "priority_queues.h"
+#include "dijkstra_workspace.h"
+#include "scc.h"
+#include "vertex_ordering.h"
 #include "thread_pool.h"
 
 ///@brief struct for the graph edge
@@ -16,59 +24,235 @@ struct Edge {
     Edge(int _dest, double _weight);
 };
 
+///@brief settings of a single Dijkstra run
+struct DijkstraOptions {
+    ///@brief priority queue used for the vertices
+    HeapType heap = HeapType::IndexedFibonacci;
+    ///@brief inserting vertices into the heap only when they are first reached instead of all V upfront
+    bool lazy_insertion = false;
+    ///@brief splitting the graph into strongly connected components and searching them in topological order
+    bool scc_decomposition = false;
+};
+
+///@brief the graph prepared for the Dijkstra phase of Johnson's algorithm
+struct ReweightedGraph {
+    ///@brief frozen edges of the original graph
+    std::shared_ptr<const CSRGraph> csr;
+    ///@brief potentials of the vertices found by Bellman-Ford
+    std::vector<double> h;
+    ///@brief non-negative weights w(u, v) + h[u] - h[v], aligned with the edges of csr
+    std::vector<double> weights;
+    ///@brief strongly connected components of csr, set only for the runs with scc_decomposition
+    std::shared_ptr<const Condensation> scc;
+};
+
+/**
+ * @brief Dijkstra algorithm over the reweighted edges
+ * @param graph the reweighted graph
+ * @param src the vertex for which we search the shortest paths
+ * @param dist distances in reweighted units, the caller converts them back with the potentials
+ * @param options the settings of the run
+ */
+void reweightedDijkstra(const ReweightedGraph& graph, int src, std::vector<double>& dist,
+                        const DijkstraOptions& options);
+
+/**
+ * @brief Dijkstra algorithm over the reweighted edges which reuses the memory of the workspace
+ * @param graph the reweighted graph
+ * @param src the vertex for which we search the shortest paths
+ * @param workspace the workspace of the current thread, distances in reweighted units stay in it
+ * @param options the settings of the run
+ */
+void reweightedDijkstra(const ReweightedGraph& graph, int src, DijkstraWorkspace& workspace,
+                        const DijkstraOptions& options);
+
 // Forward declaration
 class Graph;
+class LazyDistanceMatrix;
+class RowSink;
 
 ///@brief class for Strategy Pattern for different strategies of calculations
 class ParallelizationStrategy {
+protected:
+    ///@brief settings passed to every Dijkstra run of the strategy
+    DijkstraOptions dijkstra_options;
+
 public:
     virtual ~ParallelizationStrategy() = default;
+    ///@brief setting the priority queue used by Dijkstra
+    void setHeapType(HeapType heap) { dijkstra_options.heap = heap; }
+    ///@return the priority queue used by Dijkstra
+    HeapType getHeapType() const { return dijkstra_options.heap; }
+    ///@brief switching lazy heap population on or off
+    void setLazyInsertion(bool lazy) { dijkstra_options.lazy_insertion = lazy; }
+    ///@brief switching the strongly connected components pre-pass on or off
+    void setSccDecomposition(bool enabled) { dijkstra_options.scc_decomposition = enabled; }
+    ///@brief setting all Dijkstra options at once
+    void setDijkstraOptions(const DijkstraOptions& options) { dijkstra_options = options; }
+    ///@return Dijkstra options of the strategy
+    const DijkstraOptions& getDijkstraOptions() const { return dijkstra_options; }
     /**
      * @brief A virtual method for implementing execution
      * @param graph with type Graph
-     * @return matrix of the shortest ways between vertex
+     * @param dist V x V matrix which is filled in place with the shortest ways between vertices
+     */
+    virtual void execute(Graph& graph, DistanceMatrix& dist) = 0;
+    /**
+     * @brief computing the distances only from the given sources
+     *
+     * Runs Dijkstra from every source one after another with the cached potentials of the graph
+     * @param graph with type Graph
+     * @param sources the vertices for which we search the shortest paths, all valid
+     * @param dist sources.size() x V matrix, row i is filled with the distances from sources[i]
+     */
+    virtual void executeSources(Graph& graph, const std::vector<int>& sources, DistanceMatrix& dist);
+    /**
+     * @brief computing the whole matrix row by row and passing every row to the sink as soon as it is ready
+     *
+     * Runs Dijkstra from every vertex one after another, so only one row is in memory at a time.
+     * Calls sink.begin() before the first row and sink.finish() after the last one
+     * @param graph with type Graph
+     * @param sink the receiver of the rows
      */
-    virtual std::vector<std::vector<double>> execute(Graph& graph) = 0;
+    virtual void executeToSink(Graph& graph, RowSink& sink);
 };
 
 ///@brief class for implementing sequential strategy of computation
 class SequentialStrategy : public ParallelizationStrategy {
 public:
-    std::vector<std::vector<double>> execute(Graph& graph) override;
+    void execute(Graph& graph, DistanceMatrix& dist) override;
 };
 
-///@brief class for implementing parallel strategy of computation
-class ParallelDijkstraStrategy : public ParallelizationStrategy {
+///@brief base class for strategies which run on a thread pool
+///
+/// The thread pool is kept between execute() calls. It can also be owned by the caller and shared
+/// between several strategies, execute() of different graphs may run on one pool at the same time.
+class PooledStrategy : public ParallelizationStrategy {
 private:
     ///@brief the field which contains the number of threads
     size_t thread_count;
+    ///@brief the pool used by the strategy, created on the first execute() if not given
+    std::shared_ptr<ThreadPool> pool;
+    std::mutex pool_mutex;
+    ///@brief Dijkstra memory of the workers of workspaces_pool, released with the strategy or when the pool changes
+    std::shared_ptr<WorkerWorkspaces> workspaces;
+    const ThreadPool* workspaces_pool = nullptr;
+
+protected:
+    ///@return the pool of the strategy, creating it if needed
+    std::shared_ptr<ThreadPool> getPool();
+    ///@return one Dijkstra workspace per worker of the given pool, kept between calls
+    std::shared_ptr<WorkerWorkspaces> getWorkspaces(const ThreadPool& workers);
+
 public:
     ///@brief constructor of the class which set thread count
-    ParallelDijkstraStrategy(size_t threads = 0)
+    PooledStrategy(size_t threads = 0)
             : thread_count(threads == 0 ? std::thread::hardware_concurrency() : threads) {}
+    ///@brief constructor which uses an externally owned long-lived pool
+    explicit PooledStrategy(std::shared_ptr<ThreadPool> sharedPool)
+            : thread_count(sharedPool->getThreadCount()), pool(std::move(sharedPool)) {}
     ///@brief function which implement the opportunity to change the number of threads after creating the object of the class
-    void setThreadCount(size_t threads) { thread_count = threads; }
+    void setThreadCount(size_t threads);
     ///@return thread count
     size_t getThreadCount() const { return thread_count; }
-    std::vector<std::vector<double>> execute(Graph& graph) override;
+    ///@brief replacing the pool of the strategy with an externally owned one
+    void setThreadPool(std::shared_ptr<ThreadPool> sharedPool);
+};
+
+///@brief class for implementing parallel strategy of computation
+class ParallelDijkstraStrategy : public PooledStrategy {
+private:
+    ///@brief minimal number of sources run as one task, 0 means automatic
+    size_t grain_size = 0;
+    ///@brief the way sources are divided between threads
+    Schedule schedule = Schedule::Guided;
+
+public:
+    using PooledStrategy::PooledStrategy;
+    ///@brief setting the minimal number of sources per task, 0 chooses it automatically
+    void setGrainSize(size_t grain) { grain_size = grain; }
+    ///@brief setting the way sources are divided between threads
+    void setSchedule(Schedule newSchedule) { schedule = newSchedule; }
+    void execute(Graph& graph, DistanceMatrix& dist) override;
+    ///@brief running the sources in parallel on the pool
+    void executeSources(Graph& graph, const std::vector<int>& sources, DistanceMatrix& dist) override;
+    ///@brief running the sources on the pool in windows of a few rows per thread, so the memory is O(V * threads)
+    void executeToSink(Graph& graph, RowSink& sink) override;
+
+    /**
+     * @brief computing the whole matrix into a distance file when it does not fit into the memory
+     *
+     * The rows are computed in tiles of consecutive sources: the pool fills one tile while a single writer
+     * thread writes the previous one to the file, so two tiles are in memory at a time. Read the result with DistanceFile
+     * @param graph with type Graph
+     * @param path the file to create or overwrite
+     * @param memoryBudget the bytes for both tile buffers, a tile has at least one row
+     * @param precision the type of the stored values
+     */
+    void executeToFile(Graph& graph, const std::string& path, size_t memoryBudget,
+                       DistancePrecision precision = DistancePrecision::Double);
 };
 
 ///@brief class for the graph implementation
 class Graph {
 private:
     int V;  // Кількість вершин
-    std::vector<std::list<Edge>> adj;  // Список суміжності
+    mutable std::vector<std::vector<Edge>> adj;  // Список суміжності
     mutable std::mutex graph_mutex;
+    mutable bool frozen = false;  // ребра поки що є лише в csr, списки суміжності порожні
+    mutable std::shared_ptr<const CSRGraph> csr;  // заморожене CSR-представлення, будується за потреби
+    uint64_t version = 0;  // збільшується при кожній зміні ребер
+    mutable std::mutex reweight_mutex;
+    mutable std::shared_ptr<const ReweightedGraph> reweighted;  // кеш потенціалів для версії reweighted_version
+    mutable bool negative_cycle = false;  // кешований результат: граф містить від'ємний цикл
+    mutable uint64_t reweighted_version = 0;
+    mutable bool reweighted_valid = false;
+
+    ///@brief the cached reweighted graph, computing it with the pool if given
+    std::shared_ptr<const ReweightedGraph> loadReweighted(ThreadPool* pool, bool withComponents);
+    ///@brief applying the edge src -> dest to a matrix computed before the edge appeared or got lighter
+    ///@return false if the edge closes a negative cycle
+    bool updateAfterEdge(DistanceMatrix& dist, int src, int dest, double weight);
+    ///@brief starting a new version of the edges and dropping the CSR, graph_mutex must be held
+    void invalidate();
+    ///@brief expanding the CSR of a loaded graph into the adjacency lists before they are read or changed
+    void thaw() const;
     std::unique_ptr<ParallelizationStrategy> strategy;
+    DistancePrecision precision = DistancePrecision::Double;
+    VertexOrdering ordering = VertexOrdering::None;
+    ///@brief the copy of the graph with relabeled vertices used by johnson() when an ordering is set
+    struct OrderedGraph;
+    std::shared_ptr<OrderedGraph> ordered;  // кеш для версії ребер і впорядкування, записаних у ньому
+    std::mutex ordered_mutex;
+    ///@return the relabeled copy for the current version and ordering, building it if needed
+    std::shared_ptr<OrderedGraph> loadOrdered();
 
 public:
     Graph(int V);
+    /**
+     * @brief constructor which uses a ready CSR representation, for example a memory-mapped file
+     *
+     * The algorithms read the edges straight from the CSR, the adjacency lists are built
+     * only when the graph is changed or they are requested
+     * @param csr the edges of the graph
+     */
+    explicit Graph(std::shared_ptr<const CSRGraph> csr);
     Graph(const Graph&) = delete;
     Graph& operator=(const Graph&) = delete;
     Graph(Graph&& other) noexcept :
             V(other.V),
             adj(std::move(other.adj)),
-            strategy(std::move(other.strategy))
+            frozen(other.frozen),
+            csr(std::move(other.csr)),
+            version(other.version),
+            reweighted(std::move(other.reweighted)),
+            negative_cycle(other.negative_cycle),
+            reweighted_version(other.reweighted_version),
+            reweighted_valid(other.reweighted_valid),
+            strategy(std::move(other.strategy)),
+            precision(other.precision),
+            ordering(other.ordering),
+            ordered(std::move(other.ordered))
     // mutex ініціалізується за замовчуванням
     {}
 
@@ -76,7 +260,17 @@ public:
         if (this != &other) {
             V = other.V;
             adj = std::move(other.adj);
+            frozen = other.frozen;
+            csr = std::move(other.csr);
+            version = other.version;
+            reweighted = std::move(other.reweighted);
+            negative_cycle = other.negative_cycle;
+            reweighted_version = other.reweighted_version;
+            reweighted_valid = other.reweighted_valid;
             strategy = std::move(other.strategy);
+            precision = other.precision;
+            ordering = other.ordering;
+            ordered = std::move(other.ordered);
             // mutex не потрібно переміщати
         }
         return *this;
@@ -89,17 +283,129 @@ public:
      */
     void addEdge(int src, int dest, double weight);
 
+    /**
+     * @brief changing the weight of the edges from src to dest
+     * @param src the vertex from which is the edge
+     * @param dest the vertex where is the end of the edge
+     * @param weight the new weight of all such edges
+     * @return false if there is no such edge
+     */
+    bool setEdgeWeight(int src, int dest, double weight);
+
+    /**
+     * @brief adding an edge and updating a matrix computed before without running the whole algorithm again
+     *
+     * Only the pairs (x, y) for which the path x -> u -> v -> y gets shorter are rewritten,
+     * which costs O(V^2) in the worst case and much less when few pairs are affected
+     * @param src the vertex from which is the edge
+     * @param dest the vertex where is the end of the edge
+     * @param weight the weight of the edge
+     * @param dist V x V matrix of the shortest paths before the change
+     * @return false if the new edge closes a negative cycle, then the matrix is filled with INF
+     * @throws std::invalid_argument if a vertex is out of range or the matrix has a wrong size, the matrix is untouched
+     */
+    bool addEdge(int src, int dest, double weight, DistanceMatrix& dist);
+
+    /**
+     * @brief decreasing the weight of the edges from src to dest and updating a matrix computed before
+     * @param src the vertex from which is the edge
+     * @param dest the vertex where is the end of the edge
+     * @param weight the new weight, it must not be larger than the current weight of any such edge
+     * @param dist V x V matrix of the shortest paths before the change
+     * @return false if the edge closes a negative cycle, then the matrix is filled with INF
+     * @throws std::invalid_argument if a vertex is out of range, there is no such edge, the weight grows
+     * or the matrix has a wrong size, the graph and the matrix are untouched
+     */
+    bool decreaseEdgeWeight(int src, int dest, double weight, DistanceMatrix& dist);
+
+    ///@return the number of modifications of the edges, the cached results belong to one version
+    uint64_t getVersion() const;
+
+    /**
+     * @brief freezing the adjacency lists into the CSR representation
+     *
+     * Is called automatically by the algorithms, adding an edge afterwards invalidates the CSR
+     */
+    void finalize() const;
+
+    ///@return the frozen CSR representation of the graph, building it if needed
+    std::shared_ptr<const CSRGraph> getCSR() const;
+
+    /**
+     * @brief writing the graph into the binary file format of graph_file.h
+     * @param path the file to create or overwrite
+     * @throws std::runtime_error if the file can not be written
+     */
+    void saveBinary(const std::string& path) const;
+
+    /**
+     * @brief opening a graph written by saveBinary without parsing or copying the edges
+     *
+     * The file is memory-mapped and the algorithms read the edges from the mapped pages
+     * @param path the file to open
+     * @return the graph
+     * @throws std::runtime_error if the file can not be opened or is not a valid graph file
+     */
+    static Graph loadBinary(const std::string& path);
+
     ///@brief setting the strategy of computation
     void setStrategy(std::unique_ptr<ParallelizationStrategy> newStrategy);
 
     /**
      * @brief Bellman-Ford algorithm implementation
+     *
+     * Queue-based: only the edges of vertices whose distance has changed are relaxed,
+     * a negative cycle is reported as soon as it closes in the tree of shortest paths
      * @param src the vertex which is the start, in our case it ias fictional
      * @param dist the array which represent distances from that vertex, is used by reference
      * @return bool value if the graph contains negative cycles
      */
     bool bellmanFord(int src, std::vector<double>& dist);
 
+    /**
+     * @brief Bellman-Ford from an implicit virtual source connected to every vertex with zero weight
+     *
+     * No extra vertex or edges are materialized, all potentials simply start from 0
+     * @param h the potentials of the vertices, is used by reference
+     * @return false if the graph contains negative cycles
+     */
+    bool computePotentials(std::vector<double>& h);
+
+    /**
+     * @brief computing the potentials on the thread pool
+     *
+     * Large graphs use the parallel Bellman-Ford, small ones or a single thread the queue-based one
+     * @param h the potentials of the vertices, is used by reference
+     * @param pool the pool which runs the computation
+     * @return false if the graph contains negative cycles
+     */
+    bool computePotentials(std::vector<double>& h, ThreadPool& pool);
+
+    /**
+     * @brief computing potentials and the reweighted edges for Johnson's algorithm
+     * @param result the reweighted graph, is used by reference
+     * @return false if the graph contains negative cycles
+     */
+    bool reweight(ReweightedGraph& result);
+
+    /**
+     * @brief computing potentials and the reweighted edges on the thread pool
+     * @param result the reweighted graph, is used by reference
+     * @param pool the pool which runs the computation
+     * @return false if the graph contains negative cycles
+     */
+    bool reweight(ReweightedGraph& result, ThreadPool& pool);
+
+    /**
+     * @brief the reweighted graph cached for the current version of the edges
+     * @param withComponents also computing the strongly connected components for the SCC pre-pass
+     * @return the cached graph or nullptr if the graph contains negative cycles
+     */
+    std::shared_ptr<const ReweightedGraph> getReweighted(bool withComponents = false);
+
+    ///@brief the same, computing the potentials on the thread pool when they are not cached
+    std::shared_ptr<const ReweightedGraph> getReweighted(ThreadPool& pool, bool withComponents = false);
+
     /**
      * @brief Dijkstra algorithm using Fibonacci heap
      * @param src the vertex for which we search the shortest paths
@@ -107,17 +413,83 @@ public:
      */
     void dijkstraWithFibHeap(int src, std::vector<double>& dist);
 
+    /**
+     * @brief Dijkstra algorithm with the priority queue chosen in options
+     * @param src the vertex for which we search the shortest paths
+     * @param dist the array which represent distances from that vertex, is used by reference
+     * @param options the settings of the run
+     */
+    void dijkstra(int src, std::vector<double>& dist, const DijkstraOptions& options = DijkstraOptions());
+
+    ///@brief setting the storage type of the matrices returned by johnson()
+    void setDistancePrecision(DistancePrecision newPrecision);
+
+    /**
+     * @brief setting the relabeling of the vertices done before every johnson() call
+     *
+     * The strategy runs on a copy of the graph with the new ids, the rows and columns of the result
+     * are put back in the original order, so the callers see no difference except the speed
+     */
+    void setVertexOrdering(VertexOrdering newOrdering);
+    VertexOrdering getVertexOrdering() const { return ordering; }
+
     /**
      * @brief Johnson's algorithm
      * @return the matrix which represent the shortest paths between vertices
      */
-    std::vector<std::vector<double>> johnson();
+    DistanceMatrix johnson();
+
+    /**
+     * @brief Johnson's algorithm which fills a matrix allocated by the caller
+     * @param dist V x V matrix, its precision and alignment are kept
+     */
+    void johnson(DistanceMatrix& dist);
+
+    /**
+     * @brief Johnson's algorithm which passes the rows to the sink instead of keeping the matrix
+     *
+     * The memory stays O(V * threads). The vertex ordering is not applied here: it only changes
+     * the speed and would make the rows arrive in a scattered order
+     * @param sink the receiver of the V rows
+     */
+    void johnson(RowSink& sink);
+
+    /**
+     * @brief the shortest paths from one vertex, using the cached potentials for negative weights
+     * @param src the vertex for which we search the shortest paths
+     * @return distances to all vertices, INF for unreachable ones and for all if there is a negative cycle
+     */
+    std::vector<double> distancesFrom(int src);
+
+    /**
+     * @brief the shortest paths from a set of vertices, computed by the strategy
+     * @param sources the vertices for which we search the shortest paths
+     * @return sources.size() x V matrix, row i contains the distances from sources[i]
+     */
+    DistanceMatrix distancesFrom(const std::vector<int>& sources);
+
+    /**
+     * @brief the shortest paths from a set of vertices into a matrix allocated by the caller
+     * @param sources the vertices for which we search the shortest paths
+     * @param dist sources.size() x V matrix
+     */
+    void distancesFrom(const std::vector<int>& sources, DistanceMatrix& dist);
+
+    /**
+     * @brief the shortest paths computed row by row on demand, declared in lazy_distance_matrix.h
+     *
+     * Uses the cached potentials and the Dijkstra options of the strategy, keeps at most cacheRows rows
+     * @param cacheRows the maximal number of rows kept in memory
+     * @param pool the pool for background prefetching, may be nullptr
+     * @return the handle to the matrix, all its rows are INF if the graph contains negative cycles
+     */
+    LazyDistanceMatrix lazyJohnson(size_t cacheRows, std::shared_ptr<ThreadPool> pool = nullptr);
 
-    ///@brief function for printing matrix
+    ///@brief function for printing matrix, the rows are printed as soon as they are computed in the TsvRowSink format
     void printMatrix();
 
     // Геттери
     int getV() const;
-    const std::vector<std::list<Edge>>& getAdj() const;
-    std::vector<std::list<Edge>>& getAdjMutable();
+    const std::vector<std::vector<Edge>>& getAdj() const;
+    std::vector<std::vector<Edge>>& getAdjMutable();
 };
@@ -0,0 +1,92 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "graph.h"
+
+///@brief summary of the edges given to GraphBuilder
+struct BuildReport {
+    size_t edges = 0;                 // кількість прийнятих ребер
+    size_t rejected = 0;              // кількість відкинутих ребер
+    std::vector<std::string> errors;  // перші MAX_REPORTED_ERRORS повідомлень
+
+    static const size_t MAX_REPORTED_ERRORS = 100;
+
+    ///@return true if no edge was rejected
+    bool ok() const { return rejected == 0; }
+};
+
+///@brief bulk builder of a graph with a known number of vertices
+///
+/// Edges are added in batches into a buffer of the calling thread, so several threads may add edges
+/// at the same time without contention. build() places the edges into the CSR representation by a parallel
+/// counting sort on the thread pool. The sort is stable: the edges added by one thread keep their order,
+/// so a builder filled from a single thread gives the same adjacency as addEdge calls.
+/// Invalid edges are not printed one by one: they are counted and listed in the report.
+class GraphBuilder {
+private:
+    ///@brief the edges added by one thread
+    struct Buffer {
+        std::vector<int> src;
+        std::vector<int> dst;
+        std::vector<double> weight;
+        size_t rejected = 0;
+        std::vector<std::string> errors;
+    };
+
+    int V;
+    uint64_t id;  // відрізняє цей будівельник у кеші буферів потоку
+    std::shared_ptr<ThreadPool> pool;
+    size_t thread_count;
+    std::mutex buffers_mutex;
+    std::vector<std::unique_ptr<Buffer>> buffers;
+    std::unordered_map<std::thread::id, Buffer*> owners;  // буфер кожного потоку, що додавав ребра
+    BuildReport report;
+
+    ///@return the buffer of the calling thread, creating it on the first call
+    Buffer& localBuffer();
+    ///@return the pool, creating it on the first build
+    ThreadPool& getPool();
+
+public:
+    ///@brief constructor of the class which set thread count, 0 means hardware_concurrency()
+    GraphBuilder(int V, size_t threads = 0);
+    ///@brief constructor which uses an externally owned long-lived pool
+    GraphBuilder(int V, std::shared_ptr<ThreadPool> sharedPool);
+    GraphBuilder(const GraphBuilder&) = delete;
+    GraphBuilder& operator=(const GraphBuilder&) = delete;
+
+    int getV() const { return V; }
+
+    ///@brief reserving the buffer of the calling thread for the given number of edges
+    void reserve(size_t edges);
+
+    ///@brief adding one edge, the same checks as addEdges
+    void addEdge(int src, int dest, double weight);
+
+    /**
+     * @brief adding a batch of edges, may be called from several threads at once
+     *
+     * Edges with a vertex out of range or a weight which is not finite are rejected and reported by build()
+     * @param src the source vertices
+     * @param dest the destination vertices
+     * @param weight the weights
+     * @param count the number of edges in every array
+     */
+    void addEdges(const int* src, const int* dest, const double* weight, size_t count);
+
+    /**
+     * @brief placing all added edges into the graph
+     *
+     * Must not be called while other threads are adding edges, the builder is empty afterwards
+     * @return the graph in the CSR representation
+     */
+    Graph build();
+
+    ///@return the summary of the edges given to the last build()
+    const BuildReport& getReport() const { return report; }
+};
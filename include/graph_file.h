@@ -0,0 +1,37 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "csr_graph.h"
+
+///@brief header of the binary graph file, followed by the CSR arrays
+///
+/// Layout: the header, (V + 1) uint64 offsets, E int32 targets, padding up to 8 bytes, E double weights.
+/// Every array starts on an address aligned for its type, so the file can be used in place after mmap.
+struct GraphFileHeader {
+    char magic[8];           // "JGRAPH\0\0"
+    uint32_t format_version;
+    uint32_t byte_order;     // 0x01020304 у порядку байтів машини, що записала файл
+    uint64_t vertices;
+    uint64_t edges;
+};
+
+/**
+ * @brief writing the graph into a binary file
+ * @param path the file to create or overwrite
+ * @param g the graph
+ * @throws std::runtime_error if the file can not be written
+ */
+void writeGraphFile(const std::string& path, const CSRGraph& g);
+
+/**
+ * @brief opening a binary graph file without copying its arrays
+ *
+ * The file is memory-mapped read-only and the returned graph points straight into the mapped pages,
+ * the mapping is released together with the last copy of the graph. Where mmap is not available
+ * the arrays are read into memory.
+ * @param path the file written by writeGraphFile
+ * @return the graph
+ * @throws std::runtime_error if the file can not be opened or is not a valid graph file
+ */
+std::shared_ptr<const CSRGraph> mapGraphFile(const std::string& path);
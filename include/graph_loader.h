@@ -0,0 +1,98 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+#include "graph.h"
+
+///@brief text formats of edge lists understood by GraphLoader
+enum class GraphFormat {
+    Auto,           // за розширенням файлу (.gr, .csv, .mtx), інакше за першим рядком
+    Dimacs,         // "p sp V E", далі "a u v w", вершини з 1
+    Csv,            // "src,dst,w", вершини з 0, кількість вершин - найбільший номер + 1 (або setCompactIds)
+    MatrixMarket    // "%%MatrixMarket matrix coordinate ...", далі "rows cols nnz" і "i j w", вершини з 1
+};
+
+///@return printable name of the format
+const char* graphFormatName(GraphFormat format);
+
+///@brief summary of one load: what was read and which lines were skipped
+struct LoadReport {
+    GraphFormat format = GraphFormat::Auto;  // формат, який фактично розбирався
+    size_t lines = 0;
+    size_t edges = 0;
+    size_t skipped = 0;               // кількість рядків з помилками
+    std::vector<std::string> errors;  // перші MAX_REPORTED_ERRORS повідомлень у вигляді "line N: ..."
+    std::vector<long long> vertex_ids;  // з setCompactIds: номер вершини v у файлі - vertex_ids[v], інакше порожній
+
+    static const size_t MAX_REPORTED_ERRORS = 100;
+
+    ///@return true if every line was read
+    bool ok() const { return skipped == 0; }
+};
+
+///@brief bulk loader which builds a graph from a large text edge list
+///
+/// The body of the file is split into chunks at line boundaries, the chunks are parsed on the thread pool
+/// with std::from_chars and the edges are written into the CSR representation in one pass, so the graph
+/// is ready for the algorithms without any addEdge calls. Malformed lines do not stop the load: they are
+/// skipped and listed in the report; a CSV line with column names is one of them. Only a missing file,
+/// an unusable header or, for a format without a declared vertex count, an id far beyond the number of
+/// edges throws: such ids are renumbered with setCompactIds(true) instead.
+class GraphLoader {
+private:
+    std::shared_ptr<ThreadPool> pool;
+    size_t thread_count;
+    size_t chunk_size = 1 << 20;
+    bool compact_ids = false;
+    LoadReport last_report;
+
+    ///@return the pool, creating it on the first load
+    ThreadPool& getPool();
+    ///@brief parsing the text in [begin, end), which must stay valid until the call returns
+    Graph parseRange(const char* begin, const char* end, GraphFormat format);
+
+public:
+    ///@brief constructor of the class which set thread count, 0 means hardware_concurrency()
+    GraphLoader(size_t threads = 0);
+    ///@brief constructor which uses an externally owned long-lived pool
+    explicit GraphLoader(std::shared_ptr<ThreadPool> sharedPool);
+
+    ///@brief setting the number of bytes parsed as one task
+    void setChunkSize(size_t bytes);
+    size_t getChunkSize() const { return chunk_size; }
+
+    /**
+     * @brief renumbering the vertex ids of a file without a declared vertex count into 0..n-1
+     *
+     * The ids are ordered ascending, the id of vertex v in the file is getLastReport().vertex_ids[v].
+     * Formats with a declared vertex count keep their ids
+     * @param enabled true to renumber
+     */
+    void setCompactIds(bool enabled) { compact_ids = enabled; }
+    bool getCompactIds() const { return compact_ids; }
+
+    /**
+     * @brief reading a graph from a file
+     *
+     * Where mmap is available the file is parsed in the mapped pages without copying it into memory
+     * @param path the file
+     * @param format the format, GraphFormat::Auto detects it
+     * @return the graph, the skipped lines are listed in getLastReport()
+     * @throws std::runtime_error if the file can not be opened, its header is invalid or an id needs
+     *         far more vertices than there are edges without setCompactIds
+     */
+    Graph load(const std::string& path, GraphFormat format = GraphFormat::Auto);
+
+    /**
+     * @brief reading a graph from text already in memory
+     * @param text the content in the given format
+     * @param format the format, GraphFormat::Auto detects it from the first line
+     * @return the graph, the skipped lines are listed in getLastReport()
+     * @throws std::runtime_error if the header is invalid or an id needs far more vertices than there
+     *         are edges without setCompactIds
+     */
+    Graph parse(const std::string& text, GraphFormat format);
+
+    ///@return the report of the last load() or parse()
+    const LoadReport& getLastReport() const { return last_report; }
+};
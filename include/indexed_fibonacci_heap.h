@@ -0,0 +1,74 @@
+#pragma once
+#include <vector>
+#include <utility>
+
+///@brief fibonacci heap whose nodes live in one preallocated array indexed by vertex
+///
+/// Vertices must be in range [0, capacity). After construction no operation allocates memory,
+/// contains() and decreaseKey() are plain array lookups.
+class IndexedFibonacciHeap {
+private:
+    ///@brief the node of the heap, links are vertex indices, -1 means no node
+    struct Node {
+        double key;
+        int parent;
+        int child;
+        int left;
+        int right;
+        int degree;
+        bool mark;
+        bool in_heap;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<int> degree_table;  // таблиця для консолідації
+    std::vector<int> roots;         // буфер для обходу коренів
+    int min;
+    int n;
+
+    //додати до коренів
+    void addRoot(int x);
+    ///@brief uniting 2 trees of the same power
+    void link(int y, int x);
+
+    // Консолідація дерев
+    void consolidate();
+
+    /**
+     * @brief function for cutting the subtree
+     * @param x the subtree
+     * @param y the tree
+     */
+    void cut(int x, int y);
+
+    // Відокремлення вгору по дереву
+    void cascadingCut(int y);
+
+public:
+    ///@brief constructor which preallocates nodes for vertices [0, capacity)
+    explicit IndexedFibonacciHeap(int capacity);
+
+    // Перевіряємо, чи піраміда порожня
+    bool isEmpty() const { return min == -1; }
+
+    ///@return number of elements in the heap
+    int size() const { return n; }
+
+    // Додаємо новий вузол
+    void insert(int vertex, double key);
+
+    // Зменшуємо ключ вузла
+    void decreaseKey(int vertex, double newKey);
+
+    /**
+     * @brief deleting and returning the min element
+     * @return pair of vertex and key of the min element, {-1, INF} for empty heap
+     */
+    std::pair<int, double> extractMin();
+
+    // Перевіряємо, чи містить піраміда вершину
+    bool contains(int vertex) const { return nodes[vertex].in_heap; }
+
+    ///@brief removing all remaining elements in O(size) without freeing memory
+    void clear();
+};
@@ -0,0 +1,85 @@
+#pragma once
+#include <list>
+#include <memory>
+#include <mutex>
+#include <future>
+#include <unordered_map>
+#include <vector>
+#include "graph.h"
+
+///@brief handle to the shortest paths of a graph where rows are computed by Dijkstra on first access
+///
+/// Only the most recently used rows are kept, so the memory is bounded by the cache size instead of V^2.
+/// Rows are returned as shared pointers and stay valid for the caller after they are evicted.
+/// The handle works on a snapshot of the reweighted graph: later changes of the graph are not seen.
+/// Copies of the handle share the cache, all methods may be called from several threads.
+class LazyDistanceMatrix {
+public:
+    using RowPtr = std::shared_ptr<const std::vector<double>>;
+
+private:
+    ///@brief the state shared by the copies of the handle and by the background tasks
+    struct State {
+        int V;
+        std::shared_ptr<const ReweightedGraph> graph;  // nullptr якщо граф містить від'ємний цикл
+        DijkstraOptions options;
+        size_t capacity;
+
+        std::mutex mutex;
+        std::list<int> lru;  // від найновішого до найстарішого
+        std::unordered_map<int, std::pair<RowPtr, std::list<int>::iterator>> rows;
+        std::unordered_map<int, std::shared_future<RowPtr>> in_flight;  // рядки, які зараз рахуються
+        std::unique_ptr<WorkerWorkspaces> workspaces;  // пам'ять Дейкстри воркерів пулу для prefetch()
+
+        ///@return the row computed on the current thread with the given workspace without touching the cache
+        RowPtr compute(int src, DijkstraWorkspace& workspace) const;
+        ///@brief putting a computed row to the front of the cache and evicting the oldest ones, mutex must be held
+        void store(int src, const RowPtr& row);
+    };
+
+    std::shared_ptr<State> state;
+    // Пул належить ручці, а не стану: останнє фонове завдання не може знищити пул зсередини його потоку
+    std::shared_ptr<ThreadPool> pool;
+
+    ///@brief computing the row registered in in_flight and publishing it
+    static void fill(const std::shared_ptr<State>& state, int src, std::promise<RowPtr>& promise,
+                     DijkstraWorkspace& workspace);
+
+public:
+    /**
+     * @brief constructor, normally called by Graph::lazyJohnson
+     * @param V number of vertices
+     * @param graph the reweighted graph or nullptr if it contains a negative cycle, then all rows are INF
+     * @param options the settings of the Dijkstra runs
+     * @param capacity the maximal number of rows kept in the cache
+     * @param pool the pool for prefetch(), without it the rows are prefetched on the calling thread
+     */
+    LazyDistanceMatrix(int V, std::shared_ptr<const ReweightedGraph> graph, const DijkstraOptions& options,
+                       size_t capacity, std::shared_ptr<ThreadPool> pool = nullptr);
+
+    ///@return number of rows and columns
+    int size() const { return state->V; }
+    ///@return the maximal number of cached rows
+    size_t getCapacity() const { return state->capacity; }
+    ///@return number of rows in the cache now
+    size_t getCachedRowCount() const;
+    ///@return true if the row is in the cache now
+    bool isCached(int src) const;
+
+    /**
+     * @brief the distances from src, computing them if they are not cached
+     *
+     * A row being prefetched is waited for, except on a worker of the prefetch pool: there the row
+     * is computed on the spot, because the prefetch task may be queued behind the caller
+     * @param src the row, throws std::invalid_argument if it is out of range
+     * @return the row of V distances
+     */
+    RowPtr row(int src);
+
+    ///@return the distance from src to dest
+    double at(int src, int dest) { return (*row(src))[dest]; }
+
+    ///@brief starting the computation of the rows in the background, does not wait for them
+    ///@throws std::runtime_error if the pool is stopped, the rows which were not queued are left uncomputed
+    void prefetch(const std::vector<int>& sources);
+};
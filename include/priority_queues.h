@@ -0,0 +1,166 @@
+#pragma once
+#include <vector>
+#include <utility>
+#include <string>
+#include "constants.h"
+
+/**
+ * Priority queues which can be plugged into Graph::dijkstra.
+ *
+ * Every queue follows the same concept as FibonacciHeap: it is constructed with the number of vertices
+ * and provides isEmpty(), insert(vertex, key), decreaseKey(vertex, key), extractMin() and contains(vertex).
+ */
+
+///@brief the kind of priority queue used by Dijkstra
+enum class HeapType {
+    Fibonacci,          // FibonacciHeap, вузли в купі
+    IndexedFibonacci,   // IndexedFibonacciHeap
+    QuaternaryHeap,     // DaryHeap<4>
+    Pairing,            // PairingHeap
+    LazyBinary          // LazyBinaryHeap
+};
+
+///@return printable name of the heap type
+std::string heapTypeName(HeapType type);
+
+///@brief indexed d-ary heap, the position of every vertex is stored in an array
+template<int D>
+class DaryHeap {
+private:
+    std::vector<int> heap;     // вершини в порядку купи
+    std::vector<int> pos;      // позиція вершини в heap, -1 якщо її немає
+    std::vector<double> keys;
+
+    void siftUp(int i) {
+        int v = heap[i];
+        double key = keys[v];
+        while (i > 0) {
+            int parent = (i - 1) / D;
+            if (keys[heap[parent]] <= key) break;
+            heap[i] = heap[parent];
+            pos[heap[i]] = i;
+            i = parent;
+        }
+        heap[i] = v;
+        pos[v] = i;
+    }
+
+    void siftDown(int i) {
+        int size = static_cast<int>(heap.size());
+        int v = heap[i];
+        double key = keys[v];
+        for (;;) {
+            int first = i * D + 1;
+            if (first >= size) break;
+            int last = first + D < size ? first + D : size;
+            int best = first;
+            for (int c = first + 1; c < last; c++) {
+                if (keys[heap[c]] < keys[heap[best]]) best = c;
+            }
+            if (keys[heap[best]] >= key) break;
+            heap[i] = heap[best];
+            pos[heap[i]] = i;
+            i = best;
+        }
+        heap[i] = v;
+        pos[v] = i;
+    }
+
+public:
+    ///@brief constructor which preallocates storage for vertices [0, capacity)
+    explicit DaryHeap(int capacity) : pos(capacity, -1), keys(capacity, INF) {
+        heap.reserve(capacity);
+    }
+
+    bool isEmpty() const { return heap.empty(); }
+
+    void insert(int vertex, double key) {
+        keys[vertex] = key;
+        heap.push_back(vertex);
+        siftUp(static_cast<int>(heap.size()) - 1);
+    }
+
+    void decreaseKey(int vertex, double newKey) {
+        if (newKey > keys[vertex]) return;
+        keys[vertex] = newKey;
+        siftUp(pos[vertex]);
+    }
+
+    std::pair<int, double> extractMin() {
+        if (heap.empty()) {
+            return {-1, INF};
+        }
+        int top = heap[0];
+        pos[top] = -1;
+        int last = heap.back();
+        heap.pop_back();
+        if (!heap.empty()) {
+            heap[0] = last;
+            siftDown(0);
+        }
+        return {top, keys[top]};
+    }
+
+    bool contains(int vertex) const { return pos[vertex] != -1; }
+
+    ///@brief removing all remaining elements in O(size) without freeing memory
+    void clear() {
+        for (int v : heap) {
+            pos[v] = -1;
+        }
+        heap.clear();
+    }
+};
+
+///@brief pairing heap with nodes stored in an array indexed by vertex
+class PairingHeap {
+private:
+    struct Node {
+        double key;
+        int child;
+        int next;   // наступний брат
+        int prev;   // попередній брат або батько для першої дитини
+        bool in_heap;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<int> pairs;  // буфер для двопрохідного злиття
+    int root;
+
+    ///@brief melding two trees, returns the new root
+    int meld(int a, int b);
+    ///@brief detaching the subtree of x from its parent or siblings
+    void detach(int x);
+
+public:
+    explicit PairingHeap(int capacity);
+
+    bool isEmpty() const { return root == -1; }
+    void insert(int vertex, double key);
+    void decreaseKey(int vertex, double newKey);
+    std::pair<int, double> extractMin();
+    bool contains(int vertex) const { return nodes[vertex].in_heap; }
+    ///@brief removing all remaining elements in O(size) without freeing memory
+    void clear();
+};
+
+///@brief binary heap without decrease-key, outdated entries are skipped on extraction
+class LazyBinaryHeap {
+private:
+    std::vector<std::pair<double, int>> entries;  // (ключ, вершина)
+    std::vector<double> keys;                      // актуальний ключ вершини
+    std::vector<bool> in_heap;
+    int n;
+
+public:
+    explicit LazyBinaryHeap(int capacity);
+
+    bool isEmpty() const { return n == 0; }
+    void insert(int vertex, double key);
+    ///@brief pushing a new entry with smaller key, the old one becomes outdated
+    void decreaseKey(int vertex, double newKey);
+    std::pair<int, double> extractMin();
+    bool contains(int vertex) const { return in_heap[vertex]; }
+    ///@brief removing all remaining elements in O(number of entries) without freeing memory
+    void clear();
+};
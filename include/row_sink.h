@@ -0,0 +1,117 @@
+#pragma once
+#include <fstream>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "distance_file.h"
+
+///@brief destination of the rows of the distance matrix which are produced one by one
+///
+/// The strategies push every row as soon as its Dijkstra run finishes, so the whole matrix never has to be
+/// held in memory. writeRow() is called from the worker threads, possibly at the same time and not in
+/// the order of the rows, but the strategies never run more than a small window of rows ahead of
+/// the first unfinished one.
+class RowSink {
+public:
+    virtual ~RowSink() = default;
+
+    ///@brief called once before the first row
+    ///@param rows number of rows which will be written
+    ///@param cols number of values in every row
+    virtual void begin(int /*rows*/, int /*cols*/) {}
+
+    /**
+     * @brief receiving one finished row, must be thread-safe
+     * @param row the index of the row
+     * @param values cols distances, INF for unreachable vertices, valid only during the call
+     */
+    virtual void writeRow(int row, const double* values) = 0;
+
+    ///@brief called once after the last row, writes out everything buffered
+    virtual void finish() {}
+};
+
+///@brief sink which passes every row to a function, the calls are serialized
+class CallbackRowSink : public RowSink {
+public:
+    using Callback = std::function<void(int row, const double* values, int cols)>;
+
+private:
+    Callback callback;
+    std::mutex mutex;
+    int cols = 0;
+
+public:
+    explicit CallbackRowSink(Callback callback) : callback(std::move(callback)) {}
+    void begin(int rows, int cols) override;
+    void writeRow(int row, const double* values) override;
+};
+
+///@brief sink which writes the rows into a binary distance file
+///
+/// Every row has a fixed place in the file, so the rows may arrive in any order. Consecutive rows are
+/// collected in a buffer and written with one call, a row which does not continue the buffered run
+/// writes the buffer out first.
+class BinaryFileRowSink : public RowSink {
+private:
+    std::string path;
+    DistancePrecision precision;
+    size_t buffer_size;
+    std::ofstream out;
+    std::mutex mutex;
+    int cols = 0;
+    std::vector<char> buffer;
+    int first_row = 0;  // перший рядок у буфері
+    int buffered_rows = 0;
+
+    size_t rowBytes() const;
+    ///@brief writing the buffered rows to their place in the file, mutex must be held
+    void flush();
+
+public:
+    /**
+     * @brief constructor, the file is created by begin()
+     * @param path the file to create or overwrite
+     * @param precision the type of the stored values
+     * @param bufferBytes the size of the buffer of consecutive rows
+     */
+    explicit BinaryFileRowSink(const std::string& path, DistancePrecision precision = DistancePrecision::Double,
+                               size_t bufferBytes = 1 << 22);
+    void begin(int rows, int cols) override;
+    void writeRow(int row, const double* values) override;
+    void finish() override;
+};
+
+///@brief sink which writes the rows as text, every value followed by a tab, INF for unreachable vertices
+///
+/// The rows are formatted on the calling threads and written in the order of the rows,
+/// rows which arrive early wait in memory until the rows before them are written. By default the
+/// values have the six significant digits of printMatrix, a file meant to be read back can ask for
+/// the shortest form which restores the exact double.
+class TsvRowSink : public RowSink {
+private:
+    std::ofstream file;
+    std::ostream* out;
+    std::mutex mutex;
+    int cols = 0;
+    int next_row = 0;
+    bool round_trip;
+    std::map<int, std::string> pending;  // відформатовані рядки, що прийшли раніше за попередні
+
+public:
+    /**
+     * @brief constructor which writes into a file
+     * @param path the file
+     * @param roundTrip true to write the shortest exact form of every value instead of six digits
+     * @throws std::runtime_error if the file can not be created
+     */
+    explicit TsvRowSink(const std::string& path, bool roundTrip = false);
+    ///@brief constructor which writes into a stream owned by the caller, roundTrip as for the file
+    explicit TsvRowSink(std::ostream& stream, bool roundTrip = false);
+    void begin(int rows, int cols) override;
+    void writeRow(int row, const double* values) override;
+    void finish() override;
+};
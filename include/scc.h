@@ -0,0 +1,28 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+#include "csr_graph.h"
+
+///@brief strongly connected components of a graph numbered in topological order of the condensation
+///
+/// Every edge goes either inside a component or from a component to one with a larger number,
+/// so processing the components by increasing number visits each one after all its predecessors.
+struct Condensation {
+    ///@brief number of components
+    int count = 0;
+    ///@brief component of every vertex
+    std::vector<int> component;
+    ///@brief vertices of component c are members[offsets[c]] .. members[offsets[c + 1] - 1]
+    std::vector<size_t> offsets;
+    std::vector<int> members;
+
+    ///@return number of vertices in component c
+    size_t size(int c) const { return offsets[c + 1] - offsets[c]; }
+};
+
+/**
+ * @brief splitting the graph into strongly connected components with iterative Tarjan's algorithm
+ * @param g the graph
+ * @return the components in topological order
+ */
+Condensation condense(const CSRGraph& g);
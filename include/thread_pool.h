@@ -1,19 +1,174 @@
 #pragma once
-#include <queue>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <mutex>
 #include <condition_variable>
 #include <functional>
 #include <thread>
 #include <future>
+#include <exception>
+#include <stdexcept>
+#include <algorithm>
+
+///@brief how ThreadPool::parallelFor divides the range between threads
+enum class Schedule {
+    Stealing,   // рекурсивне ділення навпіл до grain, вільні потоки крадуть половини
+    Guided      // шматки зі спільного лічильника, їх розмір зменшується разом з рештою роботи
+};
 
 // Thread Pool Pattern
 ///@brief the class for working with threads
+///
+/// Every worker owns a deque of tasks: it takes its own tasks from the back and, when it runs out of work,
+/// steals from the front of the other deques. There is no pool-wide lock on the push/pop path,
+/// the sleep mutex is touched only when some worker is actually sleeping.
 class ThreadPool {
 private:
+    ///@brief a task in a deque: a function pointer with its data and an index range, copying it never allocates
+    struct Task {
+        void (*run)(void* data, size_t begin, size_t end);
+        void* data;
+        size_t begin;
+        size_t end;
+    };
+
+    ///@brief the deque of one worker, the owner works on the back, thieves take from the front
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    ///@brief shared state of one parallelFor call
+    template<class F>
+    struct RangeJob {
+        ThreadPool* pool;
+        F* body;
+        size_t grain;
+        size_t end;
+        size_t parts;                   // на скільки частин ділиться решта в режимі Guided
+        std::atomic<size_t> next;       // наступний невзятий індекс в режимі Guided
+        std::atomic<size_t> remaining;  // невиконані індекси разом з незавершеними допоміжними завданнями Guided
+        std::atomic<size_t> queued;     // завдання цього виклику, які лежать у чергах і ще не почались
+        std::atomic<bool> failed;
+        std::exception_ptr error;
+        std::mutex error_mutex;
+        std::atomic<bool> waiting;      // потік, що викликав, спить на done
+        bool finished = false;          // змінюється лише під done_mutex
+        std::mutex done_mutex;
+        std::condition_variable done;
+    };
+
     std::vector<std::thread> workers;
-    std::queue<std::function<void()>> tasks;
-    std::mutex queue_mutex;
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::mutex sleep_mutex;
     std::condition_variable condition;
-    bool stop;
+    std::atomic<size_t> pending;       // кількість завдань у чергах
+    std::atomic<size_t> sleeping;      // кількість потоків, що чекають на condition
+    std::atomic<size_t> next_queue;    // round-robin для потоків поза пулом
+    std::atomic<bool> stop;
+
+    ///@brief pushing a task to the deque of the current worker or, for outside threads, to the next deque
+    void push(const Task& task);
+    ///@brief taking a task from the own deque or stealing one, running it
+    ///@return false if no task was found
+    bool runPendingTask();
+    ///@brief the loop of the worker with the given index
+    void workerLoop(size_t index);
+    ///@return index of the current thread in this pool or queues.size() for outside threads
+    size_t currentIndex() const;
+    ///@brief taking a task with the given data from any deque and running it
+    ///@return false if no such task was found
+    bool runTaskOf(const void* data);
+
+    ///@brief pushing a task of a parallelFor job and waking its caller if it waits for new tasks
+    template<class F>
+    void pushJobTask(RangeJob<F>* job, const Task& task) {
+        job->queued.fetch_add(1);
+        push(task);
+        if (job->waiting.load()) {
+            std::lock_guard<std::mutex> lock(job->done_mutex);
+            job->done.notify_one();
+        }
+    }
+
+    ///@brief marking amount units of a job as done, the thread which finishes the last one wakes the caller
+    template<class F>
+    static void release(RangeJob<F>* job, size_t amount) {
+        if (job->remaining.fetch_sub(amount, std::memory_order_acq_rel) != amount) return;
+        // Потік, що викликав, виходить лише побачивши finished під м'ютексом, тож job живий до кінця цього блоку
+        std::lock_guard<std::mutex> lock(job->done_mutex);
+        job->finished = true;
+        job->done.notify_one();
+    }
+
+    ///@brief running the range of a parallelFor job, splitting off halves so that idle workers can steal them
+    template<class F>
+    static void runRange(void* data, size_t begin, size_t end) {
+        auto* job = static_cast<RangeJob<F>*>(data);
+        while (end - begin > job->grain) {
+            size_t mid = begin + (end - begin) / 2;
+            job->pool->pushJobTask(job, Task{&runQueuedRange<F>, job, mid, end});
+            end = mid;
+        }
+        runChunk(job, begin, end);
+    }
+
+    ///@brief runRange for a half taken from a deque
+    template<class F>
+    static void runQueuedRange(void* data, size_t begin, size_t end) {
+        static_cast<RangeJob<F>*>(data)->queued.fetch_sub(1);
+        runRange<F>(data, begin, end);
+    }
+
+    ///@brief taking shrinking chunks from the shared counter of a guided parallelFor job until it runs out
+    ///@param helper 1 for the tasks pushed to the workers, each of them is counted in job->remaining
+    template<class F>
+    static void runGuided(void* data, size_t helper, size_t) {
+        auto* job = static_cast<RangeJob<F>*>(data);
+        if (helper) {
+            job->queued.fetch_sub(1);
+        }
+        size_t begin = job->next.load(std::memory_order_relaxed);
+        while (begin < job->end) {
+            size_t chunk = (job->end - begin) / job->parts;
+            if (chunk < job->grain) chunk = job->grain;
+            size_t end = begin + chunk < job->end ? begin + chunk : job->end;
+            if (job->next.compare_exchange_weak(begin, end, std::memory_order_relaxed)) {
+                runChunk(job, begin, end);
+                begin = end;
+            }
+        }
+        if (helper) {
+            release(job, 1);
+        }
+    }
+
+    ///@brief calling the body for [begin, end) and marking these indices as done
+    template<class F>
+    static void runChunk(RangeJob<F>* job, size_t begin, size_t end) {
+        if (!job->failed.load(std::memory_order_relaxed)) {
+            try {
+                for (size_t i = begin; i < end; i++) {
+                    (*job->body)(i);
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(job->error_mutex);
+                if (!job->failed.exchange(true)) {
+                    job->error = std::current_exception();
+                }
+            }
+        }
+        release(job, end - begin);
+    }
+
+    ///@brief running and deleting a task created by enqueue
+    template<class T>
+    static void runOwned(void* data, size_t, size_t) {
+        std::unique_ptr<T> task(static_cast<T*>(data));
+        (*task)();
+    }
 
 public:
     ThreadPool(size_t threads);
@@ -27,25 +182,93 @@ public:
     size_t getThreadCount() const {
         return workers.size();
     }
+    ///@return index of the calling worker in [0, getThreadCount()), a larger value for threads outside the pool
+    size_t currentWorker() const {
+        size_t index = currentIndex();
+        return index < workers.size() ? index : workers.size();
+    }
     ///@brief the main function for managing the threads
     template<class F, class... Args>
     auto enqueue(F&& f, Args&&... args) -> std::future<std::invoke_result_t<F, Args...>> {
         using return_type = std::invoke_result_t<F, Args...>;
+        using task_type = std::packaged_task<return_type()>;
 
-        auto task = std::make_shared<std::packaged_task<return_type()>>(
+        auto task = std::make_unique<task_type>(
                 std::bind(std::forward<F>(f), std::forward<Args>(args)...)
         );
 
         std::future<return_type> res = task->get_future();
-        {
-            std::unique_lock<std::mutex> lock(queue_mutex);
-            if(stop)
-                throw std::runtime_error("enqueue on stopped ThreadPool");
-            tasks.emplace([task](){ (*task)(); });
-        }
-        condition.notify_one();
+        if(stop)
+            throw std::runtime_error("enqueue on stopped ThreadPool");
+        push(Task{&runOwned<task_type>, task.release(), 0, 0});
         return res;
     }
 
+    /**
+     * @brief calling body(i) for every i in [begin, end) on the pool and waiting for all of them
+     *
+     * With Schedule::Stealing the range is submitted as one job and split in halves on demand down to grain
+     * indices, so it costs O(log n) pushes to spread it over the workers. With Schedule::Guided every thread
+     * takes chunks of remaining / (2 * threads) indices, but not less than grain, from a shared counter,
+     * so chunks get smaller as the work runs out and long tail tasks are balanced.
+     * While waiting, the calling thread runs the not yet started tasks of this call, therefore parallelFor
+     * may be called from inside a task of the same pool. When none are left it sleeps until the call
+     * finishes or new tasks of the call appear, so it neither burns a core nor picks up unrelated work.
+     * The first exception thrown by body is rethrown to the caller.
+     * @param grain the minimal number of indices run as one task, 0 chooses it from the range size
+     * @param schedule the way the range is divided
+     */
+    template<class F>
+    void parallelFor(size_t begin, size_t end, F&& body, size_t grain = 0, Schedule schedule = Schedule::Stealing) {
+        if (begin >= end) return;
+
+        size_t threads = queues.size() + 1;  // разом з потоком, що викликав
+        size_t count = end - begin;
+        if (grain == 0) {
+            grain = schedule == Schedule::Guided ? 1 : count / (threads * 8);
+            if (grain == 0) grain = 1;
+        }
+
+        using Body = std::remove_reference_t<F>;
+        RangeJob<Body> job;
+        job.pool = this;
+        job.body = &body;
+        job.grain = grain;
+        job.end = end;
+        job.parts = 2 * threads;
+        job.next.store(begin);
+        job.remaining.store(count);
+        job.queued.store(0);
+        job.failed.store(false);
+        job.waiting.store(false);
+
+        if (schedule == Schedule::Guided) {
+            // Кожен воркер отримує завдання, яке бере шматки, поки вони є
+            size_t helpers = std::min(queues.size(), (count + grain - 1) / grain - 1);
+            job.remaining.fetch_add(helpers);
+            for (size_t k = 0; k < helpers; k++) {
+                pushJobTask(&job, Task{&runGuided<Body>, &job, 1, 0});
+            }
+            runGuided<Body>(&job, 0, 0);
+        } else {
+            runRange<Body>(&job, begin, end);
+        }
+
+        // Виконуємо ще не взяті завдання цього виклику, а коли їх немає - спимо до завершення або нових завдань
+        for (;;) {
+            if (runTaskOf(&job)) continue;
+            std::unique_lock<std::mutex> lock(job.done_mutex);
+            if (job.finished) break;
+            job.waiting.store(true);
+            job.done.wait(lock, [&job] { return job.finished || job.queued.load() > 0; });
+            job.waiting.store(false);
+            if (job.finished) break;
+        }
+
+        if (job.failed) {
+            std::rethrow_exception(job.error);
+        }
+    }
+
     ~ThreadPool();
-};
\ No newline at end of file
+};
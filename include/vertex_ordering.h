@@ -0,0 +1,24 @@
+#pragma once
+#include <vector>
+#include "csr_graph.h"
+
+///@brief the way vertices are relabeled before solving to improve memory locality
+enum class VertexOrdering {
+    None,
+    BFS,                    // вершини в порядку обходу в ширину
+    ReverseCuthillMcKee,    // обхід в ширину від вершини з найменшим степенем, сусіди за зростанням степеня, порядок обернено
+    DegreeSorted            // за спаданням степеня, щоб часто досяжні вершини лежали поруч
+};
+
+///@return printable name of the ordering
+const char* vertexOrderingName(VertexOrdering ordering);
+
+/**
+ * @brief computing the new order of the vertices
+ *
+ * Edges are treated as undirected, so both endpoints of an edge end up close to each other
+ * @param g the graph
+ * @param ordering the kind of the ordering
+ * @return order[i] is the original id of the vertex which gets id i, identity for VertexOrdering::None
+ */
+std::vector<int> computeVertexOrder(const CSRGraph& g, VertexOrdering ordering);
@@ -0,0 +1,231 @@
+#include "../include/auto_strategy.h"
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <cmath>
+#include <vector>
+
+namespace {
+    // Вартості в наносекундах на одному потоці, підібрані найменшими квадратами відносної похибки
+    // за часами Benchmark::benchmarkAutoStrategy (-O3, x86-64 з AVX2): випадкові графи з V = 200..1600
+    // і E/V = 1..64, шляхи і двовимірні ґратки. Модель Дейкстри потрапляє в 0.63..1.5 виміряного часу,
+    // Флойда-Воршелла - в 0.43..1.58; вибір збігся з швидшим алгоритмом у 32 з 35 графів,
+    // три промахи лежать біля точки перетину і коштують не більше 1.4 раза
+    const double FLOYD_NS_PER_RELAXATION = 0.17;     // рядок i пропускається для k, недосяжної з i
+    const double FLOYD_NS_PER_PAIR = 22.6;           // перевірка кожної пари (i, k) і заповнення матриці
+    const double DIJKSTRA_NS_PER_EDGE = 7.5;
+    const double DIJKSTRA_NS_PER_HEAP_LEVEL = 12.2;  // на досяжну вершину і рівень 4-арної купи
+    const double DIJKSTRA_NS_PER_VERTEX = 1.8;       // ініціалізація і запис рядка відстаней
+    const double BELLMAN_FORD_NS_PER_EDGE = 10.0;    // SPFA з розбиранням піддерев: 5..10 нс на ребро за прохід
+    // Досяжність оцінюється пошуком у ширину з кількох рівномірно розставлених джерел
+    const int REACH_SAMPLES = 16;
+    // parallelFor на пулі коштує 40..60 мкс, тож на 2 мс роботи розподіл забирає лише кілька відсотків
+    const double PARALLEL_MIN_NS = 2e6;
+
+    ///@brief the averages over the sampled sources, they drive the costs of both engines
+    struct ReachSample {
+        double vertices = 0;  // досяжні вершини
+        double edges = 0;     // ребра, які переглядає пошук
+        double frontier = 0;  // найширший рівень пошуку, наближення розміру купи Дейкстри
+    };
+
+    ReachSample sampleReach(const CSRGraph& g) {
+        ReachSample sample;
+        int V = g.getV();
+        int samples = std::min(V, REACH_SAMPLES);
+        std::vector<int> level(V);
+        std::vector<int> queue(V);
+        for (int s = 0; s < samples; s++) {
+            int src = static_cast<int>(static_cast<long long>(s) * V / samples);
+            std::fill(level.begin(), level.end(), -1);
+            int head = 0, tail = 0;
+            queue[tail++] = src;
+            level[src] = 0;
+            int width = 0, widest = 1;
+            size_t edges = 0;
+            for (int current = 0; head < tail; head++) {
+                int u = queue[head];
+                if (level[u] != current) {
+                    current = level[u];
+                    widest = std::max(widest, width);
+                    width = 0;
+                }
+                width++;
+                edges += g.edgesEnd(u) - g.edgesBegin(u);
+                for (size_t i = g.edgesBegin(u); i < g.edgesEnd(u); i++) {
+                    int v = g.getTargets()[i];
+                    if (level[v] < 0) {
+                        level[v] = level[u] + 1;
+                        queue[tail++] = v;
+                    }
+                }
+            }
+            sample.vertices += tail;
+            sample.edges += static_cast<double>(edges);
+            sample.frontier += std::max(widest, width);
+        }
+        sample.vertices /= samples;
+        sample.edges /= samples;
+        sample.frontier /= samples;
+        return sample;
+    }
+
+    std::string formatMs(double ns) {
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(2) << ns / 1e6 << " ms";
+        return out.str();
+    }
+}
+
+const char* autoChoiceName(AutoChoice choice) {
+    switch (choice) {
+        case AutoChoice::Sequential: return "Sequential";
+        case AutoChoice::ParallelDijkstra: return "ParallelDijkstra";
+        case AutoChoice::BlockedFloydWarshall: return "BlockedFloydWarshall";
+    }
+    return "Unknown";
+}
+
+AutoStrategy::AutoStrategy(size_t threads) : PooledStrategy(threads) {
+    // Найшвидша черга за benchmarkHeapTypes на V = 250..2000, E/V = 2..128: 4-арна купа з ледачою вставкою
+    // була першою або в межах шуму від першої, наприклад V = 1000, E/V = 8: 0.20 с проти 0.27 с Pairing,
+    // 0.34 с LazyBinary і 0.37 с IndexedFibonacci
+    dijkstra_options.heap = HeapType::QuaternaryHeap;
+    dijkstra_options.lazy_insertion = true;
+}
+
+AutoStrategy::AutoStrategy(std::shared_ptr<ThreadPool> sharedPool) : PooledStrategy(std::move(sharedPool)) {
+    dijkstra_options.heap = HeapType::QuaternaryHeap;
+    dijkstra_options.lazy_insertion = true;
+}
+
+AutoDecision AutoStrategy::choose(const Graph& graph, size_t threads) {
+    AutoDecision decision;
+    std::shared_ptr<const CSRGraph> csr = graph.getCSR();
+    double V = csr->getV();
+    double E = static_cast<double>(csr->getEdgeCount());
+
+    std::ostringstream reason;
+    reason << "V=" << csr->getV() << ", E=" << csr->getEdgeCount();
+    if (csr->getV() < 2) {
+        reason << ": nothing to compute";
+        decision.reason = reason.str();
+        return decision;
+    }
+
+    double density = E / (V * (V - 1));
+    bool negative = false;
+    const double* weights = csr->getWeights();
+    for (size_t i = 0; i < csr->getEdgeCount() && !negative; i++) {
+        negative = weights[i] < 0;
+    }
+    reason << ", density=" << std::fixed << std::setprecision(3) << density;
+    if (negative) reason << ", negative weights";
+
+    // Обидва алгоритми працюють лише з досяжними парами: Флойд-Воршелл пропускає рядок, якщо i не досягає k,
+    // Дейкстра з кожного джерела обходить лише досяжні вершини з купою розміру порядку фронту пошуку
+    ReachSample reach = sampleReach(*csr);
+    double floyd_ns = V * V * (reach.vertices * FLOYD_NS_PER_RELAXATION + FLOYD_NS_PER_PAIR);
+    double dijkstra_ns = V * (reach.edges * DIJKSTRA_NS_PER_EDGE +
+                              reach.vertices * std::log2(1 + reach.frontier) * DIJKSTRA_NS_PER_HEAP_LEVEL +
+                              V * DIJKSTRA_NS_PER_VERTEX);
+    double johnson_ns = dijkstra_ns + E * BELLMAN_FORD_NS_PER_EDGE;
+    decision.floyd_ns = floyd_ns;
+    decision.johnson_ns = johnson_ns;
+    reason << ", reach=" << std::setprecision(0) << reach.vertices;
+    reason << "; estimated Floyd-Warshall " << formatMs(floyd_ns) << ", Johnson " << formatMs(johnson_ns);
+
+    if (floyd_ns < johnson_ns) {
+        decision.choice = AutoChoice::BlockedFloydWarshall;
+        reason << ": dense graph, Floyd-Warshall is cheaper";
+    } else if (threads <= 1) {
+        decision.choice = AutoChoice::Sequential;
+        reason << ": sparse graph, only one thread available";
+    } else if (johnson_ns < PARALLEL_MIN_NS) {
+        decision.choice = AutoChoice::Sequential;
+        reason << ": too small to split between " << threads << " threads";
+    } else {
+        decision.choice = AutoChoice::ParallelDijkstra;
+        reason << ": sparse graph, Dijkstra on " << threads << " threads";
+    }
+    decision.reason = reason.str();
+    return decision;
+}
+
+void AutoStrategy::execute(Graph& graph, DistanceMatrix& dist) {
+    last_decision = choose(graph, getThreadCount());
+    if (logging) {
+        std::clog << "AutoStrategy: " << autoChoiceName(last_decision.choice)
+                  << " (" << last_decision.reason << ")" << std::endl;
+    }
+
+    ParallelizationStrategy* engine = nullptr;
+    switch (last_decision.choice) {
+        case AutoChoice::Sequential:
+            if (!sequential) sequential = std::make_unique<SequentialStrategy>();
+            engine = sequential.get();
+            break;
+        case AutoChoice::ParallelDijkstra:
+            if (!parallel) parallel = std::make_unique<ParallelDijkstraStrategy>(getPool());
+            parallel->setThreadPool(getPool());
+            engine = parallel.get();
+            break;
+        case AutoChoice::BlockedFloydWarshall:
+            if (!floyd) floyd = std::make_unique<BlockedFloydWarshallStrategy>(getPool());
+            floyd->setThreadPool(getPool());
+            engine = floyd.get();
+            break;
+    }
+    engine->setDijkstraOptions(dijkstra_options);
+    engine->execute(graph, dist);
+}
+
+void AutoStrategy::executeSources(Graph& graph, const std::vector<int>& sources, DistanceMatrix& dist) {
+    // Для кількох джерел Дейкстра завжди дешевша за повну матрицю Флойда-Воршелла
+    std::ostringstream reason;
+    reason << sources.size() << " sources";
+    if (sources.size() > 1 && getThreadCount() > 1) {
+        last_decision.choice = AutoChoice::ParallelDijkstra;
+        reason << ": Dijkstra per source on " << getThreadCount() << " threads";
+    } else {
+        last_decision.choice = AutoChoice::Sequential;
+        reason << ": Dijkstra per source on the calling thread";
+    }
+    last_decision.reason = reason.str();
+    if (logging) {
+        std::clog << "AutoStrategy: " << autoChoiceName(last_decision.choice)
+                  << " (" << last_decision.reason << ")" << std::endl;
+    }
+
+    if (last_decision.choice == AutoChoice::ParallelDijkstra) {
+        if (!parallel) parallel = std::make_unique<ParallelDijkstraStrategy>(getPool());
+        parallel->setThreadPool(getPool());
+        parallel->setDijkstraOptions(dijkstra_options);
+        parallel->executeSources(graph, sources, dist);
+    } else {
+        ParallelizationStrategy::executeSources(graph, sources, dist);
+    }
+}
+
+void AutoStrategy::executeToSink(Graph& graph, RowSink& sink) {
+    AutoDecision decision = choose(graph, getThreadCount());
+    std::ostringstream reason;
+    reason << decision.reason << "; rows are streamed, so Dijkstra is used";
+    // Як і в execute(), з одним потоком пул не створюється
+    bool parallel_rows = getThreadCount() > 1 && decision.choice != AutoChoice::Sequential;
+    last_decision.choice = parallel_rows ? AutoChoice::ParallelDijkstra : AutoChoice::Sequential;
+    last_decision.reason = reason.str();
+    if (logging) {
+        std::clog << "AutoStrategy: " << autoChoiceName(last_decision.choice)
+                  << " (" << last_decision.reason << ")" << std::endl;
+    }
+
+    if (last_decision.choice == AutoChoice::ParallelDijkstra) {
+        if (!parallel) parallel = std::make_unique<ParallelDijkstraStrategy>(getPool());
+        parallel->setThreadPool(getPool());
+        parallel->setDijkstraOptions(dijkstra_options);
+        parallel->executeToSink(graph, sink);
+    } else {
+        ParallelizationStrategy::executeToSink(graph, sink);
+    }
+}
@@ -0,0 +1,217 @@
+#include "../include/bellman_ford.h"
+#include "../include/constants.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+namespace {
+    ///@brief incoming edges of every vertex: sources and weights of the edges u -> v
+    struct ReverseCSR {
+        std::vector<size_t> offsets;
+        std::vector<int> sources;
+        std::vector<double> weights;
+    };
+
+    ReverseCSR reverseEdges(const CSRGraph& g) {
+        int V = g.getV();
+        const size_t* offsets = g.getOffsets();
+        const int* targets = g.getTargets();
+        const double* weights = g.getWeights();
+
+        // Сортування підрахунком за кінцем ребра
+        ReverseCSR rev;
+        rev.offsets.assign(V + 1, 0);
+        for (size_t i = 0; i < g.getEdgeCount(); i++) {
+            rev.offsets[targets[i] + 1]++;
+        }
+        for (int v = 0; v < V; v++) {
+            rev.offsets[v + 1] += rev.offsets[v];
+        }
+        rev.sources.resize(g.getEdgeCount());
+        rev.weights.resize(g.getEdgeCount());
+        std::vector<size_t> position(rev.offsets.begin(), rev.offsets.end() - 1);
+        for (int u = 0; u < V; u++) {
+            for (size_t i = offsets[u]; i < offsets[u + 1]; i++) {
+                size_t slot = position[targets[i]]++;
+                rev.sources[slot] = u;
+                rev.weights[slot] = weights[i];
+            }
+        }
+        return rev;
+    }
+
+    /**
+     * @brief calling body(v, part) for every vertex of the lists, their total length is split into equal parts
+     *
+     * Each part runs on one thread, so body may append to per-part buffers without locks
+     */
+    template<class F>
+    void forEachListed(ThreadPool& pool, const std::vector<std::vector<int>>& lists, F&& body) {
+        std::vector<size_t> starts(lists.size() + 1, 0);
+        for (size_t k = 0; k < lists.size(); k++) {
+            starts[k + 1] = starts[k] + lists[k].size();
+        }
+        size_t total = starts.back();
+        if (total == 0) return;
+        size_t parts = lists.size();
+
+        pool.parallelFor(0, parts, [&](size_t part) {
+            size_t begin = total * part / parts;
+            size_t end = total * (part + 1) / parts;
+            size_t list = std::upper_bound(starts.begin(), starts.end(), begin) - starts.begin() - 1;
+            for (size_t i = begin; i < end; list++) {
+                size_t stop = std::min(end, starts[list + 1]);
+                for (; i < stop; i++) {
+                    body(lists[list][i - starts[list]], part);
+                }
+            }
+        }, 1);
+    }
+}
+
+bool queueBellmanFord(const CSRGraph& g, std::vector<double>& dist) {
+    int V = g.getV();
+    const size_t* offsets = g.getOffsets();
+    const int* targets = g.getTargets();
+    const double* weights = g.getWeights();
+
+    // Дерево найкоротших шляхів як кільцевий список у прямому порядку обходу з глибинами,
+    // вершина V - уявний корінь з глибиною 0
+    std::vector<int> next(V + 1), prev(V + 1), depth(V + 1, 0);
+    std::vector<char> in_tree(V + 1, 0), in_queue(V, 0);
+    std::vector<int> queue;
+    queue.reserve(V);
+
+    int last = V;
+    for (int v = 0; v < V; v++) {
+        if (dist[v] == INF) continue;
+        next[last] = v;
+        prev[v] = last;
+        depth[v] = 1;
+        in_tree[v] = 1;
+        in_queue[v] = 1;
+        queue.push_back(v);
+        last = v;
+    }
+    next[last] = V;
+    prev[V] = last;
+    in_tree[V] = 1;
+
+    // Кільцева черга FIFO: кожна вершина в ній не більше одного разу
+    size_t head = 0;
+    size_t count = queue.size();
+    queue.resize(V > 0 ? V : 1);
+
+    while (count > 0) {
+        int u = queue[head];
+        head = (head + 1) % queue.size();
+        count--;
+        in_queue[u] = 0;
+        // Вершина з розібраного піддерева буде перерахована після покращення її предка
+        if (!in_tree[u]) continue;
+
+        for (size_t i = offsets[u]; i < offsets[u + 1]; i++) {
+            int v = targets[i];
+            double candidate = dist[u] + weights[i];
+            if (!(candidate < dist[v])) continue;
+            if (v == u) return false;
+            dist[v] = candidate;
+
+            if (in_tree[v]) {
+                // Розбираємо піддерево v, воно лежить одразу після v з більшою глибиною
+                int x = next[v];
+                while (depth[x] > depth[v]) {
+                    if (x == u) return false;
+                    in_tree[x] = 0;
+                    x = next[x];
+                }
+                next[prev[v]] = x;
+                prev[x] = prev[v];
+            }
+
+            // v стає дитиною u
+            next[v] = next[u];
+            prev[next[u]] = v;
+            next[u] = v;
+            prev[v] = u;
+            depth[v] = depth[u] + 1;
+            in_tree[v] = 1;
+
+            if (!in_queue[v]) {
+                in_queue[v] = 1;
+                queue[(head + count) % queue.size()] = v;
+                count++;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool parallelBellmanFord(const CSRGraph& g, std::vector<double>& dist, ThreadPool& pool) {
+    int V = g.getV();
+    const size_t* offsets = g.getOffsets();
+    const int* targets = g.getTargets();
+    ReverseCSR rev = reverseEdges(g);
+
+    // Другий буфер: нові значення раунду не видно іншим потокам до його кінця
+    std::vector<double> next(dist);
+    std::unique_ptr<std::atomic<unsigned char>[]> marked(new std::atomic<unsigned char>[V]);
+    for (int v = 0; v < V; v++) {
+        marked[v].store(0, std::memory_order_relaxed);
+    }
+
+    // Списки змінених і активних вершин, по одному на частину роботи
+    size_t parts = 4 * (pool.getThreadCount() + 1);
+    std::vector<std::vector<int>> changed(parts), active(parts);
+
+    // Раунд 0: усі джерела вважаються зміненими
+    pool.parallelFor(0, parts, [&](size_t part) {
+        int begin = static_cast<int>(static_cast<size_t>(V) * part / parts);
+        int end = static_cast<int>(static_cast<size_t>(V) * (part + 1) / parts);
+        for (int v = begin; v < end; v++) {
+            if (dist[v] != INF) changed[part].push_back(v);
+        }
+    }, 1);
+
+    for (int round = 1; ; round++) {
+        // Фіксуємо значення попереднього раунду і позначаємо наступників змінених вершин
+        for (auto& list : active) list.clear();
+        forEachListed(pool, changed, [&](int u, size_t part) {
+            dist[u] = next[u];
+            for (size_t i = offsets[u]; i < offsets[u + 1]; i++) {
+                int v = targets[i];
+                if (!marked[v].exchange(1, std::memory_order_relaxed)) {
+                    active[part].push_back(v);
+                }
+            }
+        });
+
+        // Кожна активна вершина бере мінімум по вхідних ребрах, читаючи лише dist
+        for (auto& list : changed) list.clear();
+        forEachListed(pool, active, [&](int v, size_t part) {
+            marked[v].store(0, std::memory_order_relaxed);
+            double best = dist[v];
+            for (size_t i = rev.offsets[v]; i < rev.offsets[v + 1]; i++) {
+                double from = dist[rev.sources[i]];
+                if (from != INF && from + rev.weights[i] < best) {
+                    best = from + rev.weights[i];
+                }
+            }
+            if (best < dist[v]) {
+                next[v] = best;
+                changed[part].push_back(v);
+            }
+        });
+
+        bool updated = std::any_of(changed.begin(), changed.end(),
+                                   [](const std::vector<int>& list) { return !list.empty(); });
+        if (!updated) {
+            return true;
+        }
+        // Найкоротший шлях має не більше V-1 ребер, зміна в раунді V означає від'ємний цикл
+        if (round >= V) {
+            return false;
+        }
+    }
+}
@@ -1,4 +1,6 @@
 #include "../include/benchmark.h"
+#include "../include/floyd_warshall.h"
+#include "../include/auto_strategy.h"
 #include <iostream>
 #include <chrono>
 #include <iomanip>
@@ -109,6 +111,7 @@ void Benchmark::benchmarkCompleteGraphs() {
     for (int V : sizes) {
         auto g1 = generateCompleteGraph(V);
         auto g2 = generateCompleteGraph(V);
+        auto g3 = generateCompleteGraph(V);
 
         std::cout << "Testing complete graph with " << V << " vertices..." << std::endl;
 
@@ -118,12 +121,84 @@ void Benchmark::benchmarkCompleteGraphs() {
         double par_time = measureTime(g2, std::make_unique<ParallelDijkstraStrategy>());
         std::cout << "  Parallel:   " << std::fixed << std::setprecision(1) << par_time << " ms" << std::endl;
 
+        double fw_time = measureTime(g3, std::make_unique<BlockedFloydWarshallStrategy>());
+        std::cout << "  Floyd-Warshall: " << std::fixed << std::setprecision(1) << fw_time << " ms" << std::endl;
+
         double speedup = seq_time / par_time;
         std::cout << "  Speedup:    " << std::fixed << std::setprecision(2) << speedup << "x" << std::endl;
         std::cout << std::endl;
     }
 }
 
+void Benchmark::benchmarkHeapTypes() {
+    std::cout << "Performance Test: Dijkstra Priority Queues (parallel strategy)" << std::endl;
+    std::cout << std::string(65, '-') << std::endl;
+
+    std::vector<HeapType> heaps = {HeapType::Fibonacci, HeapType::IndexedFibonacci, HeapType::QuaternaryHeap,
+                                   HeapType::Pairing, HeapType::LazyBinary};
+    std::vector<std::pair<int, double>> configs = {{200, 0.02}, {200, 0.5}, {400, 0.01}, {400, 0.3}};
+
+    // Невід'ємні ваги, щоб щільні графи не містили від'ємних циклів і Дейкстра справді запускалась
+    auto saved_weights = weight_dist.param();
+    weight_dist.param(std::uniform_real_distribution<double>::param_type(0.0, 100.0));
+
+    for (auto [V, density] : configs) {
+        std::cout << "V=" << V << ", density " << std::fixed << std::setprecision(2) << density << ":" << std::endl;
+
+        for (HeapType heap : heaps) {
+            double times[2];
+            for (int lazy = 0; lazy < 2; lazy++) {
+                // Однаковий граф для всіх пірамід
+                rng.seed(42 + V);
+                auto g = generateRandomGraph(V, density);
+                auto strategy = std::make_unique<ParallelDijkstraStrategy>();
+                strategy->setHeapType(heap);
+                strategy->setLazyInsertion(lazy == 1);
+                times[lazy] = measureTime(g, std::move(strategy));
+            }
+            std::cout << "  " << std::left << std::setw(18) << heapTypeName(heap) << std::right
+                      << std::setprecision(1) << "eager=" << times[0] << "ms, lazy=" << times[1] << "ms" << std::endl;
+        }
+        std::cout << std::endl;
+    }
+    weight_dist.param(saved_weights);
+}
+
+void Benchmark::benchmarkAutoStrategy() {
+    std::cout << "Performance Test: AutoStrategy cost model (one thread)" << std::endl;
+    std::cout << std::string(65, '-') << std::endl;
+
+    // Ці ж часи використано для підбору сталих моделі в auto_strategy.cpp
+    auto saved_weights = weight_dist.param();
+    weight_dist.param(std::uniform_real_distribution<double>::param_type(0.0, 100.0));
+    int right = 0, total = 0;
+    for (int V : {200, 400, 800, 1600}) {
+        for (double degree : {1.0, 2.0, 4.0, 8.0, 16.0, 32.0, 64.0}) {
+            if (degree * V * V > 1e8) continue;
+            rng.seed(42 + V);
+            auto g = generateRandomGraph(V, degree / V);
+            AutoDecision decision = AutoStrategy::choose(g, 1);
+
+            auto johnson = std::make_unique<SequentialStrategy>();
+            johnson->setHeapType(HeapType::QuaternaryHeap);
+            johnson->setLazyInsertion(true);
+            double johnson_ms = measureTime(g, std::move(johnson));
+            double floyd_ms = measureTime(g, std::make_unique<BlockedFloydWarshallStrategy>(1));
+
+            bool floyd_faster = floyd_ms < johnson_ms;
+            bool correct = floyd_faster == (decision.choice == AutoChoice::BlockedFloydWarshall);
+            right += correct;
+            total++;
+            std::cout << "V=" << V << ", E/V=" << std::fixed << std::setprecision(0) << degree << std::setprecision(1)
+                      << ": Johnson " << johnson_ms << "ms (estimated " << decision.johnson_ns / 1e6
+                      << "), Floyd-Warshall " << floyd_ms << "ms (estimated " << decision.floyd_ns / 1e6
+                      << "), chosen " << autoChoiceName(decision.choice) << (correct ? "" : " - slower") << std::endl;
+        }
+    }
+    weight_dist.param(saved_weights);
+    std::cout << "The faster engine was chosen for " << right << " of " << total << " graphs" << std::endl;
+}
+
 void Benchmark::runComprehensiveBenchmark() {
     std::cout << "Comprehensive Performance Test" << std::endl;
     std::cout << std::string(80, '=') << std::endl;
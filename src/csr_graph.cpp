@@ -0,0 +1,27 @@
+#include "../include/csr_graph.h"
+#include <utility>
+
+namespace {
+    ///@brief the arrays of a graph built in memory
+    struct OwnedArrays {
+        std::vector<size_t> offsets;
+        std::vector<int> targets;
+        std::vector<double> weights;
+    };
+}
+
+CSRGraph::CSRGraph(int V, std::vector<size_t> offsets, std::vector<int> targets, std::vector<double> weights)
+        : V(V), E(targets.size()) {
+    auto arrays = std::make_shared<OwnedArrays>();
+    arrays->offsets = std::move(offsets);
+    arrays->targets = std::move(targets);
+    arrays->weights = std::move(weights);
+    this->offsets = arrays->offsets.data();
+    this->targets = arrays->targets.data();
+    this->weights = arrays->weights.data();
+    storage = std::move(arrays);
+}
+
+CSRGraph::CSRGraph(int V, size_t E, const size_t* offsets, const int* targets, const double* weights,
+                   std::shared_ptr<const void> storage)
+        : V(V), E(E), offsets(offsets), targets(targets), weights(weights), storage(std::move(storage)) {}
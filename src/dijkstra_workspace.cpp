@@ -0,0 +1,223 @@
+#include "../include/dijkstra_workspace.h"
+#include "../include/constants.h"
+#include <algorithm>
+#include <type_traits>
+
+namespace {
+    ///@brief Dijkstra over the CSR arrays with any priority queue from priority_queues.h
+    template<class Heap>
+    void runDijkstra(const CSRGraph& g, const double* weights, int src, Heap& heap, bool lazy_insertion,
+                     std::vector<double>& dist, std::vector<unsigned>& visited, unsigned epoch,
+                     std::vector<int>& touched) {
+        int V = g.getV();
+        const size_t* offsets = g.getOffsets();
+        const int* targets = g.getTargets();
+
+        dist[src] = 0;
+        touched.push_back(src);
+
+        if (lazy_insertion) {
+            // Вершини додаються до піраміди лише при першому досягненні
+            heap.insert(src, 0);
+        } else {
+            for (int v = 0; v < V; v++) {
+                heap.insert(v, dist[v]);
+            }
+        }
+
+        while (!heap.isEmpty()) {
+            auto [u, dist_u] = heap.extractMin();
+
+            // У піраміді лишились тільки недосяжні вершини
+            if (dist_u == INF) break;
+
+            if (visited[u] == epoch) continue;
+            visited[u] = epoch;
+
+            // Релаксація ребер
+            for (size_t i = offsets[u]; i < offsets[u + 1]; i++) {
+                int v = targets[i];
+                double weight = weights[i];
+
+                if (visited[v] != epoch && dist[u] + weight < dist[v]) {
+                    if (dist[v] == INF) {
+                        touched.push_back(v);
+                    }
+                    dist[v] = dist[u] + weight;
+                    if (heap.contains(v)) {
+                        heap.decreaseKey(v, dist[v]);
+                    } else {
+                        heap.insert(v, dist[v]);
+                    }
+                }
+            }
+        }
+
+        // Після раннього виходу в піраміді можуть лишитися недосяжні вершини
+        heap.clear();
+    }
+
+    ///@brief the run of DijkstraWorkspace::runCondensed, dist holds the original distances until the end
+    template<class Heap>
+    void runCondensedDijkstra(const CSRGraph& g, const double* original, const double* reweighted,
+                              const std::vector<double>& h, const Condensation& scc, int src, Heap& heap,
+                              std::vector<double>& dist, std::vector<double>& key, std::vector<unsigned>& visited,
+                              std::vector<unsigned>& reached, unsigned epoch, std::vector<int>& touched) {
+        const size_t* offsets = g.getOffsets();
+        const int* targets = g.getTargets();
+        const std::vector<int>& component = scc.component;
+
+        dist[src] = 0;
+        touched.push_back(src);
+        reached[component[src]] = epoch;
+
+        // Ребра між компонентами релаксуються з початковими вагами
+        auto relaxOutgoing = [&](int u, int c) {
+            for (size_t i = offsets[u]; i < offsets[u + 1]; i++) {
+                int v = targets[i];
+                if (component[v] == c) continue;
+                if (dist[u] + original[i] < dist[v]) {
+                    if (dist[v] == INF) {
+                        touched.push_back(v);
+                    }
+                    dist[v] = dist[u] + original[i];
+                    reached[component[v]] = epoch;
+                }
+            }
+        };
+
+        for (int c = component[src]; c < scc.count; c++) {
+            if (reached[c] != epoch) continue;
+            const int* first = scc.members.data() + scc.offsets[c];
+            const int* last = scc.members.data() + scc.offsets[c + 1];
+
+            if (last - first == 1) {
+                // Усі вхідні ребра вже релаксовано, відстань остаточна
+                relaxOutgoing(*first, c);
+                continue;
+            }
+
+            // Дейкстра з усіх досягнутих вершин компоненти одночасно
+            for (const int* it = first; it != last; it++) {
+                if (dist[*it] != INF) {
+                    key[*it] = dist[*it] - h[*it];
+                    heap.insert(*it, key[*it]);
+                }
+            }
+            while (!heap.isEmpty()) {
+                auto [u, key_u] = heap.extractMin();
+                if (visited[u] == epoch) continue;
+                visited[u] = epoch;
+
+                for (size_t i = offsets[u]; i < offsets[u + 1]; i++) {
+                    int v = targets[i];
+                    if (component[v] != c || visited[v] == epoch) continue;
+                    double candidate = key_u + reweighted[i];
+                    if (dist[v] == INF || candidate < key[v]) {
+                        if (dist[v] == INF) {
+                            touched.push_back(v);
+                        }
+                        key[v] = candidate;
+                        dist[v] = candidate + h[v];
+                        if (heap.contains(v)) {
+                            heap.decreaseKey(v, candidate);
+                        } else {
+                            heap.insert(v, candidate);
+                        }
+                    }
+                }
+            }
+            for (const int* it = first; it != last; it++) {
+                if (dist[*it] != INF) {
+                    relaxOutgoing(*it, c);
+                }
+            }
+        }
+
+        // Переводимо у перетворені одиниці, як після звичайного запуску
+        for (int v : touched) {
+            dist[v] = dist[v] + h[src] - h[v];
+        }
+    }
+}
+
+DijkstraWorkspace::DijkstraWorkspace() : V(0), heap_type(HeapType::IndexedFibonacci), epoch(0) {}
+
+void DijkstraWorkspace::prepare(int vertices, HeapType type) {
+    if (vertices == V && type == heap_type && !std::holds_alternative<std::monostate>(heap)) {
+        return;
+    }
+
+    V = vertices;
+    heap_type = type;
+    switch (type) {
+        case HeapType::Fibonacci:
+            heap.emplace<FibonacciHeap>(V);
+            break;
+        case HeapType::IndexedFibonacci:
+            heap.emplace<IndexedFibonacciHeap>(V);
+            break;
+        case HeapType::QuaternaryHeap:
+            heap.emplace<DaryHeap<4>>(V);
+            break;
+        case HeapType::Pairing:
+            heap.emplace<PairingHeap>(V);
+            break;
+        case HeapType::LazyBinary:
+            heap.emplace<LazyBinaryHeap>(V);
+            break;
+    }
+    dist.assign(V, INF);
+    visited.assign(V, 0);
+    epoch = 0;
+    touched.clear();
+    touched.reserve(V);
+    scratch.assign(V, INF);
+}
+
+void DijkstraWorkspace::reset() {
+    for (int v : touched) {
+        dist[v] = INF;
+    }
+    touched.clear();
+
+    // При переповненні лічильника позначки скидаються повністю
+    if (++epoch == 0) {
+        std::fill(visited.begin(), visited.end(), 0);
+        std::fill(reached.begin(), reached.end(), 0);
+        epoch = 1;
+    }
+}
+
+void DijkstraWorkspace::run(const CSRGraph& g, const double* weights, int src, bool lazy_insertion) {
+    reset();
+    std::visit([&](auto& h) {
+        using Heap = std::decay_t<decltype(h)>;
+        if constexpr (!std::is_same_v<Heap, std::monostate>) {
+            runDijkstra(g, weights, src, h, lazy_insertion, dist, visited, epoch, touched);
+        }
+    }, heap);
+}
+
+void DijkstraWorkspace::runCondensed(const CSRGraph& g, const double* original, const double* reweighted,
+                                     const std::vector<double>& h, const Condensation& scc, int src) {
+    reset();
+    if (reached.size() != static_cast<size_t>(scc.count)) {
+        reached.assign(scc.count, 0);
+    }
+    std::visit([&](auto& heap_impl) {
+        using Heap = std::decay_t<decltype(heap_impl)>;
+        if constexpr (!std::is_same_v<Heap, std::monostate>) {
+            runCondensedDijkstra(g, original, reweighted, h, scc, src, heap_impl, dist, scratch, visited,
+                                 reached, epoch, touched);
+        }
+    }, heap);
+}
+
+// WorkerWorkspaces implementation
+WorkerWorkspaces::WorkerWorkspaces(size_t workers) {
+    slots.reserve(workers);
+    for (size_t i = 0; i < workers; i++) {
+        slots.push_back(std::make_unique<DijkstraWorkspace>());
+    }
+}
@@ -0,0 +1,263 @@
+#include "../include/distance_file.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define JOHNSON_HAS_MMAP 1
+#endif
+
+namespace {
+    const char DISTANCE_MAGIC[8] = {'J', 'D', 'I', 'S', 'T', 0, 0, 0};
+    const uint32_t DISTANCE_FORMAT_VERSION = 1;
+    const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+    static_assert(sizeof(DistanceFileHeader) == 64, "the values must start at byte 64");
+
+    ///@brief checking the header read from the file
+    void validate(const DistanceFileHeader& header, uint64_t file_size, const std::string& path) {
+        if (std::memcmp(header.magic, DISTANCE_MAGIC, sizeof(DISTANCE_MAGIC)) != 0) {
+            throw std::runtime_error(path + " is not a distance file");
+        }
+        if (header.byte_order != BYTE_ORDER_MARK) {
+            throw std::runtime_error(path + " was written on a machine with a different byte order");
+        }
+        if (header.format_version != DISTANCE_FORMAT_VERSION) {
+            throw std::runtime_error(path + " has unsupported format version " + std::to_string(header.format_version));
+        }
+        if (header.element_size != sizeof(float) && header.element_size != sizeof(double)) {
+            throw std::runtime_error(path + " has unsupported element size");
+        }
+        if (header.rows > static_cast<uint64_t>(std::numeric_limits<int>::max()) ||
+            header.cols > static_cast<uint64_t>(std::numeric_limits<int>::max())) {
+            throw std::runtime_error(path + " has too many rows or columns");
+        }
+        // Ділення замість множення: добуток rows * cols * element_size може переповнити 64 біти
+        uint64_t stored = (file_size - sizeof(DistanceFileHeader)) / header.element_size;
+        if (header.rows != 0 && header.cols > stored / header.rows) {
+            throw std::runtime_error(path + " is truncated");
+        }
+    }
+}
+
+DistanceFileHeader makeDistanceFileHeader(int rows, int cols, DistancePrecision precision) {
+    DistanceFileHeader header{};
+    std::memcpy(header.magic, DISTANCE_MAGIC, sizeof(DISTANCE_MAGIC));
+    header.format_version = DISTANCE_FORMAT_VERSION;
+    header.byte_order = BYTE_ORDER_MARK;
+    header.rows = static_cast<uint64_t>(rows);
+    header.cols = static_cast<uint64_t>(cols);
+    header.element_size = precision == DistancePrecision::Float ? sizeof(float) : sizeof(double);
+    return header;
+}
+
+// DistanceFileWriter implementation
+DistanceFileWriter::DistanceFileWriter(const std::string& path, int rows, int cols, DistancePrecision precision)
+        : path(path), rows(rows), cols(cols), precision(precision) {
+    DistanceFileHeader header = makeDistanceFileHeader(rows, cols, precision);
+    uint64_t total = sizeof(header) + static_cast<uint64_t>(rows) * getRowBytes();
+#ifdef JOHNSON_HAS_MMAP
+    fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open " + path + " for writing");
+    }
+    // Файл одразу отримує кінцевий розмір, плитки записуються в довільному порядку
+    if (::ftruncate(fd, static_cast<off_t>(total)) != 0 ||
+        ::pwrite(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header))) {
+        ::close(fd);
+        fd = -1;
+        throw std::runtime_error("Failed to write " + path);
+    }
+#else
+    out = std::make_unique<std::ofstream>(path, std::ios::binary | std::ios::trunc);
+    if (!*out) {
+        throw std::runtime_error("Cannot open " + path + " for writing");
+    }
+    out->write(reinterpret_cast<const char*>(&header), sizeof(header));
+    if (total > sizeof(header)) {
+        out->seekp(static_cast<std::streamoff>(total - 1));
+        out->put('\0');
+    }
+    if (!*out) {
+        throw std::runtime_error("Failed to write " + path);
+    }
+#endif
+}
+
+DistanceFileWriter::~DistanceFileWriter() {
+    try {
+        close();
+    } catch (...) {
+        // Помилку запису повідомляє лише явний виклик close()
+    }
+}
+
+size_t DistanceFileWriter::getRowBytes() const {
+    return static_cast<size_t>(cols) * (precision == DistancePrecision::Float ? sizeof(float) : sizeof(double));
+}
+
+void DistanceFileWriter::writeRows(int firstRow, int count, const void* data) {
+    if (firstRow < 0 || count < 0 || firstRow + count > rows) {
+        throw std::invalid_argument("Rows [" + std::to_string(firstRow) + ", " + std::to_string(firstRow + count) +
+                                    ") are out of range");
+    }
+    uint64_t offset = sizeof(DistanceFileHeader) + static_cast<uint64_t>(firstRow) * getRowBytes();
+    size_t size = static_cast<size_t>(count) * getRowBytes();
+#ifdef JOHNSON_HAS_MMAP
+    if (fd < 0) {
+        throw std::runtime_error(path + " is closed");
+    }
+    // pwrite може записати менше, ніж просили, тому дописуємо в циклі
+    const char* bytes = static_cast<const char*>(data);
+    while (size > 0) {
+        ssize_t written = ::pwrite(fd, bytes, size, static_cast<off_t>(offset));
+        if (written <= 0) {
+            throw std::runtime_error("Failed to write " + path);
+        }
+        bytes += written;
+        offset += static_cast<uint64_t>(written);
+        size -= static_cast<size_t>(written);
+    }
+#else
+    std::lock_guard<std::mutex> lock(out_mutex);
+    if (!out || !out->is_open()) {
+        throw std::runtime_error(path + " is closed");
+    }
+    out->seekp(static_cast<std::streamoff>(offset));
+    out->write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    if (!*out) {
+        throw std::runtime_error("Failed to write " + path);
+    }
+#endif
+}
+
+void DistanceFileWriter::close() {
+#ifdef JOHNSON_HAS_MMAP
+    if (fd >= 0) {
+        int result = ::close(fd);
+        fd = -1;
+        if (result != 0) {
+            throw std::runtime_error("Failed to write " + path);
+        }
+    }
+#else
+    std::lock_guard<std::mutex> lock(out_mutex);
+    if (out && out->is_open()) {
+        out->close();
+        if (!*out) {
+            throw std::runtime_error("Failed to write " + path);
+        }
+    }
+#endif
+}
+
+// DistanceFile implementation
+DistanceFile::DistanceFile(const std::string& path) : path(path) {
+    DistanceFileHeader header{};
+#ifdef JOHNSON_HAS_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open " + path);
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || static_cast<uint64_t>(info.st_size) < sizeof(header)) {
+        ::close(fd);
+        throw std::runtime_error(path + " is not a distance file");
+    }
+    size_t size = static_cast<size_t>(info.st_size);
+    void* address = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (address == MAP_FAILED) {
+        throw std::runtime_error("Cannot map " + path);
+    }
+    mapping = std::shared_ptr<const void>(address, [size](const void* p) {
+        ::munmap(const_cast<void*>(p), size);
+    });
+    std::memcpy(&header, address, sizeof(header));
+    validate(header, size, path);
+    values = static_cast<const unsigned char*>(address) + sizeof(header);
+#else
+    in.open(path, std::ios::binary | std::ios::ate);
+    if (!in) {
+        throw std::runtime_error("Cannot open " + path);
+    }
+    uint64_t size = static_cast<uint64_t>(in.tellg());
+    in.seekg(0);
+    if (size < sizeof(header) || !in.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        throw std::runtime_error(path + " is not a distance file");
+    }
+    validate(header, size, path);
+#endif
+    rows = static_cast<int>(header.rows);
+    cols = static_cast<int>(header.cols);
+    precision = header.element_size == sizeof(float) ? DistancePrecision::Float : DistancePrecision::Double;
+}
+
+void DistanceFile::readValues(size_t index, size_t count, double* out) const {
+    if (values) {
+        if (precision == DistancePrecision::Float) {
+            const float* stored = reinterpret_cast<const float*>(values) + index;
+            std::copy(stored, stored + count, out);
+        } else {
+            std::memcpy(out, reinterpret_cast<const double*>(values) + index, count * sizeof(double));
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(in_mutex);
+    in.seekg(static_cast<std::streamoff>(sizeof(DistanceFileHeader) + index * elementSize()));
+    if (precision == DistancePrecision::Float) {
+        std::vector<float> stored(count);
+        in.read(reinterpret_cast<char*>(stored.data()), static_cast<std::streamsize>(count * sizeof(float)));
+        std::copy(stored.begin(), stored.end(), out);
+    } else {
+        in.read(reinterpret_cast<char*>(out), static_cast<std::streamsize>(count * sizeof(double)));
+    }
+    if (!in) {
+        throw std::runtime_error("Failed to read " + path);
+    }
+}
+
+double DistanceFile::at(int row, int col) const {
+    if (row < 0 || row >= rows || col < 0 || col >= cols) {
+        throw std::out_of_range("Entry (" + std::to_string(row) + ", " + std::to_string(col) + ") is out of range");
+    }
+    double value;
+    readValues(static_cast<size_t>(row) * cols + col, 1, &value);
+    return value;
+}
+
+std::vector<double> DistanceFile::readRow(int row) const {
+    if (row < 0 || row >= rows) {
+        throw std::out_of_range("Row " + std::to_string(row) + " is out of range");
+    }
+    std::vector<double> result(cols);
+    readValues(static_cast<size_t>(row) * cols, cols, result.data());
+    return result;
+}
+
+void DistanceFile::readTile(int firstRow, DistanceMatrix& dist) const {
+    if (dist.getCols() != cols) {
+        throw std::invalid_argument("Tile must have " + std::to_string(cols) + " columns");
+    }
+    if (firstRow < 0 || firstRow + dist.getRows() > rows) {
+        throw std::out_of_range("Rows [" + std::to_string(firstRow) + ", " + std::to_string(firstRow + dist.getRows()) +
+                                ") are out of range");
+    }
+    std::vector<double> row(cols);
+    for (int i = 0; i < dist.getRows(); i++) {
+        readValues(static_cast<size_t>(firstRow + i) * cols, cols, row.data());
+        dist.setRow(i, row.data());
+    }
+}
+
+DistanceMatrix DistanceFile::readTile(int firstRow, int count) const {
+    DistanceMatrix dist(count, cols, precision);
+    readTile(firstRow, dist);
+    return dist;
+}
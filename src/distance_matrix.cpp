@@ -0,0 +1,74 @@
+#include "../include/distance_matrix.h"
+#include "../include/constants.h"
+#include <new>
+#include <stdexcept>
+#include <string>
+
+void DistanceMatrix::AlignedDeleter::operator()(unsigned char* p) const {
+    ::operator delete[](p, std::align_val_t(alignment));
+}
+
+DistanceMatrix::DistanceMatrix()
+        : rows(0), cols(0), precision(DistancePrecision::Double), alignment(CACHE_LINE), stride(0),
+          buffer(nullptr, AlignedDeleter{CACHE_LINE}) {}
+
+DistanceMatrix::DistanceMatrix(int rows, int cols, DistancePrecision precision, size_t alignment)
+        : rows(rows), cols(cols), precision(precision), alignment(alignment), stride(0),
+          buffer(nullptr, AlignedDeleter{alignment}) {
+    // Вирівнювання, яке не є степенем двійки, дає невизначену поведінку aligned operator new
+    if (alignment < alignof(double) || (alignment & (alignment - 1)) != 0) {
+        throw std::invalid_argument("Alignment " + std::to_string(alignment) +
+                                    " must be a power of two not less than " + std::to_string(alignof(double)));
+    }
+    // Довжина рядка округлюється вгору до кратної вирівнюванню
+    size_t per_line = alignment / elementSize();
+    if (per_line == 0) per_line = 1;
+    stride = (static_cast<size_t>(cols) + per_line - 1) / per_line * per_line;
+
+    size_t bytes = getByteSize();
+    if (bytes > 0) {
+        buffer.reset(static_cast<unsigned char*>(::operator new[](bytes, std::align_val_t(alignment))));
+    }
+    fill(INF);
+}
+
+double DistanceMatrix::at(int row, int col) const {
+    if (precision == DistancePrecision::Float) {
+        return rowData<float>(row)[col];
+    }
+    return rowData<double>(row)[col];
+}
+
+void DistanceMatrix::set(int row, int col, double value) {
+    if (precision == DistancePrecision::Float) {
+        rowData<float>(row)[col] = static_cast<float>(value);
+    } else {
+        rowData<double>(row)[col] = value;
+    }
+}
+
+void DistanceMatrix::setRow(int row, const double* values) {
+    if (precision == DistancePrecision::Float) {
+        float* out = rowData<float>(row);
+        for (int j = 0; j < cols; j++) {
+            out[j] = static_cast<float>(values[j]);
+        }
+    } else {
+        double* out = rowData<double>(row);
+        for (int j = 0; j < cols; j++) {
+            out[j] = values[j];
+        }
+    }
+}
+
+void DistanceMatrix::fill(double value) {
+    for (int i = 0; i < rows; i++) {
+        if (precision == DistancePrecision::Float) {
+            float* out = rowData<float>(i);
+            for (size_t j = 0; j < stride; j++) out[j] = static_cast<float>(value);
+        } else {
+            double* out = rowData<double>(i);
+            for (size_t j = 0; j < stride; j++) out[j] = value;
+        }
+    }
+}
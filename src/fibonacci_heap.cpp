@@ -121,6 +121,9 @@ void FibonacciHeap::cascadingCut(FibNode* y) {
 }
 
 FibonacciHeap::FibonacciHeap() : min(nullptr), n(0) {}
+FibonacciHeap::FibonacciHeap(int capacity) : min(nullptr), n(0) {
+    nodes.reserve(capacity);
+}
 FibonacciHeap::~FibonacciHeap() {
     // Очищаємо пам'ять від усіх вузлів
     for (auto& pair : nodes) {
@@ -197,4 +200,13 @@ std::pair<int, double> FibonacciHeap::extractMin() {
 }
 bool FibonacciHeap::contains(int vertex) const {
     return nodes.find(vertex) != nodes.end();
+}
+
+void FibonacciHeap::clear() {
+    for (auto& pair : nodes) {
+        delete pair.second;
+    }
+    nodes.clear();
+    min = nullptr;
+    n = 0;
 }
\ No newline at end of file
@@ -0,0 +1,195 @@
+#include "../include/floyd_warshall.h"
+#include "../include/constants.h"
+#include <iostream>
+#include <algorithm>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define JOHNSON_X86_SIMD 1
+#endif
+
+namespace {
+    ///@brief row[j] = min(row[j], base + krow[j]) for j in [0, count), plain loop for any type
+    template<class T>
+    void minPlusScalar(T* row, const T* krow, T base, int count) {
+        for (int j = 0; j < count; j++) {
+            T candidate = base + krow[j];
+            if (candidate < row[j]) row[j] = candidate;
+        }
+    }
+
+#ifdef JOHNSON_X86_SIMD
+    __attribute__((target("avx2")))
+    void minPlusAvx2(double* row, const double* krow, double base, int count) {
+        __m256d b = _mm256_set1_pd(base);
+        int j = 0;
+        for (; j + 4 <= count; j += 4) {
+            __m256d candidate = _mm256_add_pd(b, _mm256_loadu_pd(krow + j));
+            _mm256_storeu_pd(row + j, _mm256_min_pd(_mm256_loadu_pd(row + j), candidate));
+        }
+        minPlusScalar(row + j, krow + j, base, count - j);
+    }
+
+    __attribute__((target("avx2")))
+    void minPlusAvx2(float* row, const float* krow, float base, int count) {
+        __m256 b = _mm256_set1_ps(base);
+        int j = 0;
+        for (; j + 8 <= count; j += 8) {
+            __m256 candidate = _mm256_add_ps(b, _mm256_loadu_ps(krow + j));
+            _mm256_storeu_ps(row + j, _mm256_min_ps(_mm256_loadu_ps(row + j), candidate));
+        }
+        minPlusScalar(row + j, krow + j, base, count - j);
+    }
+
+    __attribute__((target("sse2")))
+    void minPlusSse2(double* row, const double* krow, double base, int count) {
+        __m128d b = _mm_set1_pd(base);
+        int j = 0;
+        for (; j + 2 <= count; j += 2) {
+            __m128d candidate = _mm_add_pd(b, _mm_loadu_pd(krow + j));
+            _mm_storeu_pd(row + j, _mm_min_pd(_mm_loadu_pd(row + j), candidate));
+        }
+        minPlusScalar(row + j, krow + j, base, count - j);
+    }
+
+    __attribute__((target("sse2")))
+    void minPlusSse2(float* row, const float* krow, float base, int count) {
+        __m128 b = _mm_set1_ps(base);
+        int j = 0;
+        for (; j + 4 <= count; j += 4) {
+            __m128 candidate = _mm_add_ps(b, _mm_loadu_ps(krow + j));
+            _mm_storeu_ps(row + j, _mm_min_ps(_mm_loadu_ps(row + j), candidate));
+        }
+        minPlusScalar(row + j, krow + j, base, count - j);
+    }
+
+    ///@return true if the processor supports AVX2, detected once on the first call
+    bool hasAvx2() {
+        // Статична змінна в функції не залежить від порядку ініціалізації глобальних об'єктів
+        static const bool supported = []() {
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2") != 0;
+        }();
+        return supported;
+    }
+#endif
+
+    template<class T>
+    void minPlus(T* row, const T* krow, T base, int count) {
+#ifdef JOHNSON_X86_SIMD
+        if (hasAvx2()) {
+            minPlusAvx2(row, krow, base, count);
+        } else {
+            minPlusSse2(row, krow, base, count);
+        }
+#else
+        minPlusScalar(row, krow, base, count);
+#endif
+    }
+
+    ///@brief the matrix of type T split into blocks
+    template<class T>
+    struct BlockedMatrix {
+        DistanceMatrix& matrix;
+        int V;
+        int block;
+
+        int begin(int b) const { return b * block; }
+        int end(int b) const { return std::min(V, (b + 1) * block); }
+
+        /**
+         * @brief relaxing block (bi, bj) through the vertices of block bk
+         *
+         * The loop over k is the outermost one, so the block may coincide with (bi, bk) or (bk, bj),
+         * which is needed in the first two phases.
+         */
+        void relax(int bi, int bj, int bk) {
+            int j0 = begin(bj);
+            int width = end(bj) - j0;
+            for (int k = begin(bk); k < end(bk); k++) {
+                const T* krow = matrix.rowData<T>(k) + j0;
+                for (int i = begin(bi); i < end(bi); i++) {
+                    T* row = matrix.rowData<T>(i);
+                    T base = row[k];
+                    if (base == static_cast<T>(INF)) continue;
+                    minPlus(row + j0, krow, base, width);
+                }
+            }
+        }
+    };
+
+    template<class T>
+    void runFloydWarshall(const CSRGraph& g, DistanceMatrix& dist, ThreadPool& pool, int block_size) {
+        int V = g.getV();
+        const int* targets = g.getTargets();
+        const double* weights = g.getWeights();
+
+        // Початкова матриця: 0 на діагоналі, мінімальна вага серед паралельних ребер
+        dist.fill(INF);
+        for (int u = 0; u < V; u++) {
+            T* row = dist.rowData<T>(u);
+            row[u] = 0;
+            for (size_t i = g.edgesBegin(u); i < g.edgesEnd(u); i++) {
+                T w = static_cast<T>(weights[i]);
+                if (w < row[targets[i]]) row[targets[i]] = w;
+            }
+        }
+
+        BlockedMatrix<T> blocks{dist, V, block_size};
+        int count = (V + block_size - 1) / block_size;
+
+        for (int bk = 0; bk < count; bk++) {
+            // Фаза 1: діагональний блок
+            blocks.relax(bk, bk, bk);
+
+            // Фаза 2: рядок і стовпець блоків діагонального блоку
+            pool.parallelFor(0, 2 * static_cast<size_t>(count), [&](size_t t) {
+                int b = static_cast<int>(t / 2);
+                if (b == bk) return;
+                if (t % 2 == 0) {
+                    blocks.relax(bk, b, bk);
+                } else {
+                    blocks.relax(b, bk, bk);
+                }
+            }, 1);
+
+            // Фаза 3: решта блоків незалежні одне від одного
+            pool.parallelFor(0, static_cast<size_t>(count) * count, [&](size_t t) {
+                int bi = static_cast<int>(t / count);
+                int bj = static_cast<int>(t % count);
+                if (bi == bk || bj == bk) return;
+                blocks.relax(bi, bj, bk);
+            }, 1);
+        }
+    }
+
+    ///@return true if some vertex lies on a negative cycle
+    bool hasNegativeDiagonal(const DistanceMatrix& dist) {
+        for (int v = 0; v < dist.getRows(); v++) {
+            // NaN теж означає цикл: від'ємні значення на циклі можуть переповнитися до -INF
+            if (!(dist.at(v, v) >= 0)) return true;
+        }
+        return false;
+    }
+}
+
+void BlockedFloydWarshallStrategy::setBlockSize(int size) {
+    // Кратність 8 зберігає вирівнювання блоків по лінії кешу
+    block_size = std::max(8, (size + 7) / 8 * 8);
+}
+
+void BlockedFloydWarshallStrategy::execute(Graph& graph, DistanceMatrix& dist) {
+    std::shared_ptr<const CSRGraph> g = graph.getCSR();
+    std::shared_ptr<ThreadPool> workers = getPool();
+
+    if (dist.getPrecision() == DistancePrecision::Float) {
+        runFloydWarshall<float>(*g, dist, *workers, block_size);
+    } else {
+        runFloydWarshall<double>(*g, dist, *workers, block_size);
+    }
+
+    if (hasNegativeDiagonal(dist)) {
+        std::cout << "Граф містить цикл з від'ємною вагою!" << std::endl;
+        dist.fill(INF);
+    }
+}
@@ -1,12 +1,30 @@
 #include "../include/graph.h"
 #include "../include/constants.h"
 #include "../include/thread_pool.h"
+#include "../include/bellman_ford.h"
+#include "../include/lazy_distance_matrix.h"
+#include "../include/graph_file.h"
+#include "../include/row_sink.h"
+#include "../include/distance_file.h"
 #include <iostream>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
 #include <algorithm>
 #include <thread>
-#include <future>
 #include <vector>
-#include <list>
+#include <stdexcept>
+#include <string>
+
+namespace {
+    ///@brief throwing std::invalid_argument if the edge src -> dest does not fit a graph with V vertices
+    void checkVertices(int src, int dest, int V) {
+        if (src < 0 || src >= V || dest < 0 || dest >= V) {
+            throw std::invalid_argument("Invalid vertex indices. Vertices must be in range [0, " +
+                                        std::to_string(V - 1) + "]");
+        }
+    }
+}
 
 // Edge implementation
 Edge::Edge(int _dest, double _weight) : dest(_dest), weight(_weight) {}
@@ -14,242 +32,869 @@ Edge::Edge(int _dest, double _weight) : dest(_dest), weight(_weight) {}
 // Graph implementation
 Graph::Graph(int V) : V(V), adj(V) {}
 
+Graph::Graph(std::shared_ptr<const CSRGraph> csr) : V(csr->getV()), adj(V), frozen(true), csr(std::move(csr)) {}
+
+void Graph::thaw() const {
+    std::lock_guard<std::mutex> lock(graph_mutex);
+    if (!frozen) return;
+    for (int u = 0; u < V; u++) {
+        adj[u].reserve(csr->edgesEnd(u) - csr->edgesBegin(u));
+        for (size_t i = csr->edgesBegin(u); i < csr->edgesEnd(u); i++) {
+            adj[u].emplace_back(csr->getTargets()[i], csr->getWeights()[i]);
+        }
+    }
+    frozen = false;
+}
+
 void Graph::addEdge(int src, int dest, double weight) {
     if (src < 0 || src >= V || dest < 0 || dest >= V) {
         std::cout << "Error: Invalid vertex indices. Vertices must be in range [0, " << V-1 << "]" << std::endl;
         return;
     }
+    thaw();
     adj[src].push_back(Edge(dest, weight));
+
+    std::lock_guard<std::mutex> lock(graph_mutex);
+    invalidate();
+}
+
+bool Graph::setEdgeWeight(int src, int dest, double weight) {
+    if (src < 0 || src >= V || dest < 0 || dest >= V) {
+        std::cout << "Error: Invalid vertex indices. Vertices must be in range [0, " << V-1 << "]" << std::endl;
+        return false;
+    }
+    thaw();
+    bool found = false;
+    for (Edge& e : adj[src]) {
+        if (e.dest == dest) {
+            e.weight = weight;
+            found = true;
+        }
+    }
+    if (!found) {
+        std::cout << "Error: There is no edge from " << src << " to " << dest << std::endl;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(graph_mutex);
+    invalidate();
+    return true;
+}
+
+bool Graph::addEdge(int src, int dest, double weight, DistanceMatrix& dist) {
+    if (dist.getRows() != V || dist.getCols() != V) {
+        throw std::invalid_argument("Distance matrix must be " + std::to_string(V) + "x" + std::to_string(V));
+    }
+    // false означає лише від'ємний цикл, тому помилки виклику не можуть повертатись так само
+    checkVertices(src, dest, V);
+    addEdge(src, dest, weight);
+    return updateAfterEdge(dist, src, dest, weight);
+}
+
+bool Graph::decreaseEdgeWeight(int src, int dest, double weight, DistanceMatrix& dist) {
+    if (dist.getRows() != V || dist.getCols() != V) {
+        throw std::invalid_argument("Distance matrix must be " + std::to_string(V) + "x" + std::to_string(V));
+    }
+    checkVertices(src, dest, V);
+    thaw();
+    bool found = false;
+    for (const Edge& e : adj[src]) {
+        if (e.dest != dest) continue;
+        if (e.weight < weight) {
+            throw std::invalid_argument("Only a weight decrease can be applied to a computed matrix");
+        }
+        found = true;
+    }
+    if (!found) {
+        throw std::invalid_argument("There is no edge " + std::to_string(src) + " -> " + std::to_string(dest));
+    }
+    setEdgeWeight(src, dest, weight);
+    return updateAfterEdge(dist, src, dest, weight);
+}
+
+uint64_t Graph::getVersion() const {
+    std::lock_guard<std::mutex> lock(graph_mutex);
+    return version;
+}
+
+void Graph::invalidate() {
+    version++;
+    csr.reset();
+    // Кеш потенціалів лишається, але належить старій версії і більше не використовується
+    reweighted.reset();
+}
+
+void Graph::finalize() const {
+    getCSR();
+}
+
+std::shared_ptr<const CSRGraph> Graph::getCSR() const {
+    std::lock_guard<std::mutex> lock(graph_mutex);
+    if (csr) {
+        return csr;
+    }
+
+    std::vector<size_t> offsets(V + 1, 0);
+    for (int u = 0; u < V; u++) {
+        offsets[u + 1] = offsets[u] + adj[u].size();
+    }
+
+    std::vector<int> targets;
+    std::vector<double> weights;
+    targets.reserve(offsets[V]);
+    weights.reserve(offsets[V]);
+    for (int u = 0; u < V; u++) {
+        for (const Edge& e : adj[u]) {
+            targets.push_back(e.dest);
+            weights.push_back(e.weight);
+        }
+    }
+
+    csr = std::make_shared<const CSRGraph>(V, std::move(offsets), std::move(targets), std::move(weights));
+    return csr;
+}
+
+void Graph::saveBinary(const std::string& path) const {
+    writeGraphFile(path, *getCSR());
+}
+
+Graph Graph::loadBinary(const std::string& path) {
+    return Graph(mapGraphFile(path));
 }
 
 void Graph::setStrategy(std::unique_ptr<ParallelizationStrategy> newStrategy) {
     strategy = std::move(newStrategy);
 }
 
-bool Graph::bellmanFord(int src, std::vector<double>& dist) {
-    dist.assign(V, INF);
-    dist[src] = 0;
+namespace {
+    // Менше ребер паралельний Беллман-Форд не окупає
+    const size_t PARALLEL_BELLMAN_FORD_MIN_EDGES = 1 << 15;
 
-    // Релаксація ребер V-1 разів
-    for (int i = 0; i < V - 1; i++) {
-        bool updated = false;
+    ///@brief writing w(u, v) + h[u] - h[v] for the edges of vertices [begin, end) into the already sized result.weights
+    void fillReweightedEdges(ReweightedGraph& result, int begin, int end) {
+        const CSRGraph& g = *result.csr;
+        const int* targets = g.getTargets();
+        const double* weights = g.getWeights();
+        const std::vector<double>& h = result.h;
 
-        for (int u = 0; u < V; u++) {
-            if (dist[u] == INF) continue;
+        for (int u = begin; u < end; u++) {
+            for (size_t i = g.edgesBegin(u); i < g.edgesEnd(u); i++) {
+                result.weights[i] = weights[i] + h[u] - h[targets[i]];
+            }
+        }
+    }
 
-            for (const Edge &e: adj[u]) {
-                int v = e.dest;
-                double weight = e.weight;
+    /**
+     * @brief turning the matrix of the relabeled graph into the matrix of the original one in place
+     *
+     * Afterwards dist[order[i]][order[j]] holds what was dist[i][j]. The columns of every row are reordered
+     * through one scratch row, then the rows are moved along the cycles of the permutation,
+     * so no second V x V matrix is needed
+     */
+    template<class T>
+    void unpermuteInPlace(DistanceMatrix& dist, const std::vector<int>& order, const std::vector<int>& position) {
+        int V = static_cast<int>(order.size());
+        std::vector<T> scratch(V);
+        for (int i = 0; i < V; i++) {
+            T* row = dist.rowData<T>(i);
+            std::copy(row, row + V, scratch.begin());
+            for (int c = 0; c < V; c++) {
+                row[c] = scratch[position[c]];
+            }
+        }
 
-                if (dist[u] + weight < dist[v]) {
-                    dist[v] = dist[u] + weight;
-                    updated = true;
+        // Рядок p бере вміст рядка position[p], кожен цикл перестановки проходиться один раз
+        std::vector<bool> placed(V, false);
+        for (int start = 0; start < V; start++) {
+            if (placed[start]) continue;
+            T* first = dist.rowData<T>(start);
+            std::copy(first, first + V, scratch.begin());
+            int p = start;
+            while (true) {
+                placed[p] = true;
+                int from = position[p];
+                T* row = dist.rowData<T>(p);
+                if (from == start) {
+                    std::copy(scratch.begin(), scratch.end(), row);
+                    break;
                 }
+                const T* source = dist.rowData<T>(from);
+                std::copy(source, source + V, row);
+                p = from;
             }
         }
+    }
 
-        if (!updated) break;
+    /**
+     * @brief d[x][y] = min(d[x][y], d[x][u] + w + d[v][y]) for the pairs which can improve
+     *
+     * If the path x -> y gets shorter through the new edge, then u -> y gets shorter too, so the columns
+     * are taken from row u and the rows from column v, all other pairs are not touched
+     */
+    template<class T>
+    void relaxThroughEdge(DistanceMatrix& dist, int u, int v, T w) {
+        int V = dist.getRows();
+        const T inf = static_cast<T>(INF);
+
+        std::vector<int> columns;
+        const T* from_u = dist.rowData<T>(u);
+        const T* from_v = dist.rowData<T>(v);
+        for (int y = 0; y < V; y++) {
+            if (from_v[y] != inf && w + from_v[y] < from_u[y]) {
+                columns.push_back(y);
+            }
+        }
+        if (columns.empty()) return;
+
+        // Рядок v не змінюється: інакше шлях v -> u -> v був би від'ємним циклом
+        for (int x = 0; x < V; x++) {
+            T* row = dist.rowData<T>(x);
+            T to_u = row[u];
+            if (to_u == inf || !(to_u + w < row[v])) continue;
+            for (int y : columns) {
+                T candidate = to_u + w + from_v[y];
+                if (candidate < row[y]) row[y] = candidate;
+            }
+        }
     }
 
-    // Перевіряємо наявність циклів з від'ємною вагою
-    for (int u = 0; u < V; u++) {
-        if (dist[u] == INF) continue;
+    /**
+     * @brief converting the distances of the last Dijkstra run back to the original weights
+     * @param src the source of the run
+     * @param workspace the workspace after the run from src
+     * @param h the potentials of the vertices
+     * @return the distances, kept in the scratch buffer of the workspace until its next use
+     */
+    const double* johnsonRow(int src, DijkstraWorkspace& workspace, const std::vector<double>& h) {
+        const std::vector<double>& reached = workspace.getDist();
+        std::vector<double>& values = workspace.getScratch();
+        int V = static_cast<int>(reached.size());
 
-        for (const Edge& e : adj[u]) {
-            int v = e.dest;
-            double weight = e.weight;
+        // Перетворюємо відстані назад
+        for (int v = 0; v < V; v++) {
+            values[v] = reached[v] == INF ? INF : reached[v] - h[src] + h[v];
+        }
+        return values.data();
+    }
 
-            if (dist[u] + weight < dist[v]) {
-                return false;
+    /**
+     * @brief converting the distances of the last run back to the original weights and writing them into the matrix
+     * @param dist the matrix of the strategy
+     * @param row the row to write
+     * @param src the source of the run
+     * @param workspace the workspace after the run from src
+     * @param h the potentials of the vertices
+     */
+    void storeJohnsonRow(DistanceMatrix& dist, int row, int src, DijkstraWorkspace& workspace,
+                         const std::vector<double>& h) {
+        dist.setRow(row, johnsonRow(src, workspace, h));
+    }
+
+    ///@brief the result for a graph with a negative cycle: all rows are INF
+    void writeInfRows(RowSink& sink, int V) {
+        std::vector<double> row(V, INF);
+        for (int src = 0; src < V; src++) {
+            sink.writeRow(src, row.data());
+        }
+    }
+
+    // Скільки рядків на потік рахується наперед: більше вікно - менше очікування, але більше рядків у пам'яті
+    const size_t SINK_ROWS_PER_THREAD = 16;
+
+    ///@brief one thread which writes the finished tiles into the file while the next tile is computed
+    ///
+    /// Only one tile is handed over at a time: submit() waits until the previous tile is written,
+    /// so its buffer may be reused. An error of a write is rethrown by the next submit() or by finish().
+    class TileWriter {
+    private:
+        DistanceFileWriter& writer;
+        std::mutex mutex;
+        std::condition_variable changed;
+        bool has_tile = false;
+        bool stopping = false;
+        int first = 0;
+        int count = 0;
+        const char* data = nullptr;
+        std::exception_ptr error;
+        std::thread worker;
+
+        void run() {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (true) {
+                changed.wait(lock, [this]() { return has_tile || stopping; });
+                if (!has_tile) return;
+                lock.unlock();
+                std::exception_ptr failure;
+                try {
+                    writer.writeRows(first, count, data);
+                } catch (...) {
+                    failure = std::current_exception();
+                }
+                lock.lock();
+                if (failure && !error) error = failure;
+                has_tile = false;
+                changed.notify_all();
+            }
+        }
+
+        ///@brief waiting until the handed tile is written, mutex must be held
+        void waitWritten(std::unique_lock<std::mutex>& lock) {
+            changed.wait(lock, [this]() { return !has_tile; });
+            if (error) std::rethrow_exception(error);
+        }
+
+    public:
+        explicit TileWriter(DistanceFileWriter& writer) : writer(writer), worker(&TileWriter::run, this) {}
+
+        ~TileWriter() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
             }
+            changed.notify_all();
+            worker.join();
+        }
+
+        ///@brief handing over count rows starting from firstRow, the buffer must stay unchanged until the next call
+        void submit(int firstRow, int rows, const char* buffer) {
+            std::unique_lock<std::mutex> lock(mutex);
+            waitWritten(lock);
+            first = firstRow;
+            count = rows;
+            data = buffer;
+            has_tile = true;
+            changed.notify_all();
         }
+
+        ///@brief waiting until the last tile is written
+        void finish() {
+            std::unique_lock<std::mutex> lock(mutex);
+            waitWritten(lock);
+        }
+    };
+}
+
+bool Graph::updateAfterEdge(DistanceMatrix& dist, int src, int dest, double weight) {
+    // Новий цикл dest -> src -> dest з від'ємною вагою
+    double back = dist.at(dest, src);
+    if (back != INF && back + weight < 0) {
+        std::cout << "Граф містить цикл з від'ємною вагою!" << std::endl;
+        dist.fill(INF);
+        return false;
     }
 
+    if (dist.getPrecision() == DistancePrecision::Float) {
+        relaxThroughEdge<float>(dist, src, dest, static_cast<float>(weight));
+    } else {
+        relaxThroughEdge<double>(dist, src, dest, weight);
+    }
     return true;
 }
 
-void Graph::dijkstraWithFibHeap(int src, std::vector<double>& dist) {
+bool Graph::bellmanFord(int src, std::vector<double>& dist) {
+    std::shared_ptr<const CSRGraph> g = getCSR();
     dist.assign(V, INF);
     dist[src] = 0;
+    return queueBellmanFord(*g, dist);
+}
 
-    FibonacciHeap heap;
-    std::vector<bool> processed(V, false);
+bool Graph::computePotentials(std::vector<double>& h) {
+    std::shared_ptr<const CSRGraph> g = getCSR();
+    // Уявна вершина s з нульовими ребрами до всіх вершин: після першого раунду всі відстані дорівнюють 0
+    h.assign(V, 0);
+    return queueBellmanFord(*g, h);
+}
 
-    for (int v = 0; v < V; v++) {
-        heap.insert(v, dist[v]);
+bool Graph::computePotentials(std::vector<double>& h, ThreadPool& pool) {
+    std::shared_ptr<const CSRGraph> g = getCSR();
+    h.assign(V, 0);
+    // На малих графах і одному потоці синхронні раунди програють черзі
+    if (pool.getThreadCount() < 2 || g->getEdgeCount() < PARALLEL_BELLMAN_FORD_MIN_EDGES) {
+        return queueBellmanFord(*g, h);
     }
+    return parallelBellmanFord(*g, h, pool);
+}
 
-    while (!heap.isEmpty()) {
-        auto [u, dist_u] = heap.extractMin();
+bool Graph::reweight(ReweightedGraph& result) {
+    result.csr = getCSR();
+    if (!computePotentials(result.h)) {
+        return false;
+    }
+    result.weights.resize(result.csr->getEdgeCount());
+    fillReweightedEdges(result, 0, V);
+    return true;
+}
 
-        if (processed[u]) continue;
-        processed[u] = true;
+bool Graph::reweight(ReweightedGraph& result, ThreadPool& pool) {
+    result.csr = getCSR();
+    if (!computePotentials(result.h, pool)) {
+        return false;
+    }
+    result.weights.resize(result.csr->getEdgeCount());
+    pool.parallelFor(0, V, [&result](size_t u) {
+        fillReweightedEdges(result, static_cast<int>(u), static_cast<int>(u) + 1);
+    });
+    return true;
+}
 
-        // Релаксація ребер
-        for (const Edge& e : adj[u]) {
-            int v = e.dest;
-            double weight = e.weight;
+std::shared_ptr<const ReweightedGraph> Graph::getReweighted(bool withComponents) {
+    return loadReweighted(nullptr, withComponents);
+}
 
-            if (!processed[v] && dist[u] != INF && dist[u] + weight < dist[v]) {
-                dist[v] = dist[u] + weight;
-                if (heap.contains(v)) {
-                    heap.decreaseKey(v, dist[v]);
-                }
+std::shared_ptr<const ReweightedGraph> Graph::getReweighted(ThreadPool& pool, bool withComponents) {
+    return loadReweighted(&pool, withComponents);
+}
+
+std::shared_ptr<const ReweightedGraph> Graph::loadReweighted(ThreadPool* pool, bool withComponents) {
+    // Один потік рахує потенціали, решта чекають і беруть готовий результат
+    std::lock_guard<std::mutex> compute(reweight_mutex);
+    std::shared_ptr<const ReweightedGraph> cached;
+    uint64_t current;
+    {
+        std::lock_guard<std::mutex> lock(graph_mutex);
+        current = version;
+        if (reweighted_valid && reweighted_version == current) {
+            if (negative_cycle) {
+                return nullptr;
             }
+            cached = reweighted;
         }
     }
+    if (cached && (!withComponents || cached->scc)) {
+        return cached;
+    }
+
+    auto result = std::make_shared<ReweightedGraph>();
+    bool ok = true;
+    if (cached) {
+        *result = *cached;
+    } else {
+        ok = pool ? reweight(*result, *pool) : reweight(*result);
+    }
+    if (ok && withComponents) {
+        result->scc = std::make_shared<const Condensation>(condense(*result->csr));
+    }
+
+    std::lock_guard<std::mutex> lock(graph_mutex);
+    // Ребра могли змінитися, поки ми рахували: тоді результат не кешується
+    if (version == current) {
+        reweighted_valid = true;
+        reweighted_version = current;
+        negative_cycle = !ok;
+        reweighted = ok ? result : nullptr;
+    }
+    if (!ok) {
+        return nullptr;
+    }
+    return result;
 }
 
-std::vector<std::vector<double>> Graph::johnson() {
-    return strategy->execute(*this);
+void Graph::dijkstraWithFibHeap(int src, std::vector<double>& dist) {
+    dijkstra(src, dist, DijkstraOptions());
 }
 
-void Graph::printMatrix() {
-    std::vector<std::vector<double>> dist = johnson();
-    std::cout << "Matrix of the shortest paths:" << std::endl;
+void Graph::dijkstra(int src, std::vector<double>& dist, const DijkstraOptions& options) {
+    std::shared_ptr<const CSRGraph> g = getCSR();
+    DijkstraWorkspace workspace;
+    workspace.prepare(V, options.heap);
+    workspace.run(*g, g->getWeights(), src, options.lazy_insertion);
+    dist = workspace.getDist();
+}
+
+void reweightedDijkstra(const ReweightedGraph& graph, int src, std::vector<double>& dist,
+                        const DijkstraOptions& options) {
+    DijkstraWorkspace workspace;
+    reweightedDijkstra(graph, src, workspace, options);
+    dist = workspace.getDist();
+}
+
+void reweightedDijkstra(const ReweightedGraph& graph, int src, DijkstraWorkspace& workspace,
+                        const DijkstraOptions& options) {
+    workspace.prepare(graph.csr->getV(), options.heap);
+    if (options.scc_decomposition && graph.scc) {
+        workspace.runCondensed(*graph.csr, graph.csr->getWeights(), graph.weights.data(), graph.h, *graph.scc, src);
+    } else {
+        workspace.run(*graph.csr, graph.weights.data(), src, options.lazy_insertion);
+    }
+}
+
+void Graph::setDistancePrecision(DistancePrecision newPrecision) {
+    precision = newPrecision;
+}
+
+DistanceMatrix Graph::johnson() {
+    DistanceMatrix dist(V, V, precision);
+    johnson(dist);
+    return dist;
+}
+
+void Graph::setVertexOrdering(VertexOrdering newOrdering) {
+    ordering = newOrdering;
+}
+
+struct Graph::OrderedGraph {
+    VertexOrdering ordering;
+    uint64_t version;
+    std::vector<int> order;     // вершина order[i] стає вершиною i
+    std::vector<int> position;  // обернена перестановка
+    Graph graph;                // не змінюється, тому його кеш потенціалів лишається дійсним між викликами
+
+    OrderedGraph(VertexOrdering ordering, uint64_t version, std::vector<int> order, std::vector<int> position,
+                 std::shared_ptr<const CSRGraph> csr)
+            : ordering(ordering), version(version), order(std::move(order)), position(std::move(position)),
+              graph(std::move(csr)) {}
+};
+
+std::shared_ptr<Graph::OrderedGraph> Graph::loadOrdered() {
+    std::lock_guard<std::mutex> build(ordered_mutex);
+    uint64_t current = getVersion();
+    if (ordered && ordered->version == current && ordered->ordering == ordering) {
+        return ordered;
+    }
+
+    std::shared_ptr<const CSRGraph> source = getCSR();
+    std::vector<int> order = computeVertexOrder(*source, ordering);
+    std::vector<int> position(V);
     for (int i = 0; i < V; i++) {
-        for (int j = 0; j < V; j++) {
-            if (dist[i][j] == INF)
-                std::cout << "INF\t";
-            else
-                std::cout << dist[i][j] << "\t";
+        position[order[i]] = i;
+    }
+
+    // Переставлений граф будується одразу в CSR, тому працює і для графу, завантаженого з файлу
+    std::vector<size_t> offsets(V + 1, 0);
+    for (int i = 0; i < V; i++) {
+        offsets[i + 1] = offsets[i] + (source->edgesEnd(order[i]) - source->edgesBegin(order[i]));
+    }
+    std::vector<int> targets;
+    std::vector<double> weights;
+    targets.reserve(offsets[V]);
+    weights.reserve(offsets[V]);
+    for (int i = 0; i < V; i++) {
+        for (size_t e = source->edgesBegin(order[i]); e < source->edgesEnd(order[i]); e++) {
+            targets.push_back(position[source->getTargets()[e]]);
+            weights.push_back(source->getWeights()[e]);
         }
-        std::cout << std::endl;
     }
+
+    auto result = std::make_shared<OrderedGraph>(
+            ordering, current, std::move(order), std::move(position),
+            std::make_shared<const CSRGraph>(V, std::move(offsets), std::move(targets), std::move(weights)));
+    result->graph.precision = precision;
+    // Ребра могли змінитися, поки будувалася копія: тоді вона не кешується
+    if (getVersion() == current) {
+        ordered = result;
+    }
+    return result;
+}
+
+void Graph::johnson(DistanceMatrix& dist) {
+    if (dist.getRows() != V || dist.getCols() != V) {
+        throw std::invalid_argument("Distance matrix must be " + std::to_string(V) + "x" + std::to_string(V));
+    }
+    if (ordering == VertexOrdering::None) {
+        strategy->execute(*this, dist);
+        return;
+    }
+
+    std::shared_ptr<OrderedGraph> relabeled = loadOrdered();
+    // Стратегія пише матрицю переставленого графу прямо в dist, потім рядки і стовпці повертаються на місця
+    strategy->execute(relabeled->graph, dist);
+    if (dist.getPrecision() == DistancePrecision::Float) {
+        unpermuteInPlace<float>(dist, relabeled->order, relabeled->position);
+    } else {
+        unpermuteInPlace<double>(dist, relabeled->order, relabeled->position);
+    }
+}
+
+std::vector<double> Graph::distancesFrom(int src) {
+    if (src < 0 || src >= V) {
+        throw std::invalid_argument("Source vertex " + std::to_string(src) + " is out of range");
+    }
+    DijkstraOptions options = strategy ? strategy->getDijkstraOptions() : DijkstraOptions();
+    std::vector<double> dist;
+    std::shared_ptr<const ReweightedGraph> graph = getReweighted(options.scc_decomposition);
+    if (!graph) {
+        std::cout << "Граф містить цикл з від'ємною вагою!" << std::endl;
+        dist.assign(V, INF);
+        return dist;
+    }
+
+    reweightedDijkstra(*graph, src, dist, options);
+    // Перетворюємо відстані назад
+    for (int v = 0; v < V; v++) {
+        if (dist[v] != INF) dist[v] = dist[v] - graph->h[src] + graph->h[v];
+    }
+    return dist;
+}
+
+DistanceMatrix Graph::distancesFrom(const std::vector<int>& sources) {
+    DistanceMatrix dist(static_cast<int>(sources.size()), V, precision);
+    distancesFrom(sources, dist);
+    return dist;
+}
+
+void Graph::distancesFrom(const std::vector<int>& sources, DistanceMatrix& dist) {
+    if (dist.getRows() != static_cast<int>(sources.size()) || dist.getCols() != V) {
+        throw std::invalid_argument("Distance matrix must be " + std::to_string(sources.size()) + "x" + std::to_string(V));
+    }
+    for (int src : sources) {
+        if (src < 0 || src >= V) {
+            throw std::invalid_argument("Source vertex " + std::to_string(src) + " is out of range");
+        }
+    }
+    strategy->executeSources(*this, sources, dist);
+}
+
+LazyDistanceMatrix Graph::lazyJohnson(size_t cacheRows, std::shared_ptr<ThreadPool> pool) {
+    DijkstraOptions options = strategy ? strategy->getDijkstraOptions() : DijkstraOptions();
+    std::shared_ptr<const ReweightedGraph> graph = getReweighted(options.scc_decomposition);
+    if (!graph) {
+        std::cout << "Граф містить цикл з від'ємною вагою!" << std::endl;
+    }
+    return LazyDistanceMatrix(V, std::move(graph), options, cacheRows, std::move(pool));
+}
+
+void Graph::johnson(RowSink& sink) {
+    strategy->executeToSink(*this, sink);
+}
+
+void Graph::printMatrix() {
+    std::cout << "Matrix of the shortest paths:\n";
+    TsvRowSink sink(std::cout);
+    johnson(sink);
 }
 
 int Graph::getV() const {
     return V;
 }
 
-const std::vector<std::list<Edge>>& Graph::getAdj() const {
+const std::vector<std::vector<Edge>>& Graph::getAdj() const {
+    thaw();
     return adj;
 }
 
-std::vector<std::list<Edge>>& Graph::getAdjMutable() {
+std::vector<std::vector<Edge>>& Graph::getAdjMutable() {
+    // Списки можуть бути змінені ззовні, тому CSR доведеться перебудувати
+    thaw();
+    std::lock_guard<std::mutex> lock(graph_mutex);
+    invalidate();
     return adj;
 }
 
 // SequentialStrategy implementation
-std::vector<std::vector<double>> SequentialStrategy::execute(Graph& graph) {
+void SequentialStrategy::execute(Graph& graph, DistanceMatrix& dist) {
     int V = graph.getV();
 
-    // Створюємо копію оригінального графу
-    Graph originalGraph(V);
-    for (int u = 0; u < V; u++) {
-        for (const Edge& e : graph.getAdj()[u]) {
-            originalGraph.addEdge(u, e.dest, e.weight);
-        }
+    // Потенціали і перетворені ваги, обчислені для поточної версії графу або взяті з кешу
+    std::shared_ptr<const ReweightedGraph> reweighted = graph.getReweighted(dijkstra_options.scc_decomposition);
+    if (!reweighted) {
+        std::cout << "Граф містить цикл з від'ємною вагою!" << std::endl;
+        dist.fill(INF);
+        return;
     }
+    const std::vector<double>& h = reweighted->h;
 
-    // Створюємо новий граф з додатковою вершиною s
-    Graph g(V + 1);
-    for (int u = 0; u < V; u++) {
-        for (const Edge& e : originalGraph.getAdj()[u]) {
-            g.addEdge(u, e.dest, e.weight);
-        }
-    }
+    // Послідовно запускаємо Дейкстру з кожної вершини, пам'ять одна на всі запуски
+    DijkstraWorkspace workspace;
 
-    // Додаємо ребра з нульовою вагою від s до всіх вершин
-    for (int v = 0; v < V; v++) {
-        g.addEdge(V, v, 0);
+    for (int src = 0; src < V; src++) {
+        reweightedDijkstra(*reweighted, src, workspace, dijkstra_options);
+        storeJohnsonRow(dist, src, src, workspace, h);
     }
+}
 
-    // Запускаємо Беллмана-Форда з вершини s
-    std::vector<double> h;
-    if (!g.bellmanFord(V, h)) {
+// ParallelizationStrategy implementation
+void ParallelizationStrategy::executeSources(Graph& graph, const std::vector<int>& sources, DistanceMatrix& dist) {
+    std::shared_ptr<const ReweightedGraph> reweighted = graph.getReweighted(dijkstra_options.scc_decomposition);
+    if (!reweighted) {
         std::cout << "Граф містить цикл з від'ємною вагою!" << std::endl;
-        return std::vector<std::vector<double>>(V, std::vector<double>(V, INF));
+        dist.fill(INF);
+        return;
     }
 
-    // Створюємо граф з перетвореними вагами
-    Graph transformedGraph(V);
-    for (int u = 0; u < V; u++) {
-        for (const Edge& e : originalGraph.getAdj()[u]) {
-            double newWeight = e.weight + h[u] - h[e.dest];
-            transformedGraph.addEdge(u, e.dest, newWeight);
-        }
+    DijkstraWorkspace workspace;
+    for (size_t i = 0; i < sources.size(); i++) {
+        reweightedDijkstra(*reweighted, sources[i], workspace, dijkstra_options);
+        storeJohnsonRow(dist, static_cast<int>(i), sources[i], workspace, reweighted->h);
     }
+}
 
-    // Послідовно запускаємо Дейкстру з кожної вершини
-    std::vector<std::vector<double>> dist(V, std::vector<double>(V, INF));
+void ParallelizationStrategy::executeToSink(Graph& graph, RowSink& sink) {
+    int V = graph.getV();
+    sink.begin(V, V);
+    std::shared_ptr<const ReweightedGraph> reweighted = graph.getReweighted(dijkstra_options.scc_decomposition);
+    if (!reweighted) {
+        std::cout << "Граф містить цикл з від'ємною вагою!" << std::endl;
+        writeInfRows(sink, V);
+        sink.finish();
+        return;
+    }
 
+    DijkstraWorkspace workspace;
     for (int src = 0; src < V; src++) {
-        transformedGraph.dijkstraWithFibHeap(src, dist[src]);
+        reweightedDijkstra(*reweighted, src, workspace, dijkstra_options);
+        sink.writeRow(src, johnsonRow(src, workspace, reweighted->h));
+    }
+    sink.finish();
+}
 
-        // Перетворюємо відстані назад
-        for (int v = 0; v < V; v++) {
-            if (dist[src][v] != INF) {
-                dist[src][v] = dist[src][v] - h[src] + h[v];
-            }
-        }
+// PooledStrategy implementation
+void PooledStrategy::setThreadCount(size_t threads) {
+    std::lock_guard<std::mutex> lock(pool_mutex);
+    thread_count = threads;
+    // Пул з іншою кількістю потоків буде створено при наступному виклику
+    if (pool && pool->getThreadCount() != threads) {
+        pool.reset();
+        workspaces.reset();
     }
+}
 
-    return dist;
+void PooledStrategy::setThreadPool(std::shared_ptr<ThreadPool> sharedPool) {
+    std::lock_guard<std::mutex> lock(pool_mutex);
+    thread_count = sharedPool->getThreadCount();
+    if (sharedPool != pool) {
+        workspaces.reset();
+    }
+    pool = std::move(sharedPool);
+}
+
+std::shared_ptr<ThreadPool> PooledStrategy::getPool() {
+    std::lock_guard<std::mutex> lock(pool_mutex);
+    if (!pool) {
+        pool = std::make_shared<ThreadPool>(std::max<size_t>(thread_count, 1));
+    }
+    return pool;
+}
+
+std::shared_ptr<WorkerWorkspaces> PooledStrategy::getWorkspaces(const ThreadPool& workers) {
+    std::lock_guard<std::mutex> lock(pool_mutex);
+    // Слоти прив'язані до воркерів одного пулу: для іншого пулу вони створюються заново
+    if (!workspaces || workspaces_pool != &workers) {
+        workspaces = std::make_shared<WorkerWorkspaces>(workers.getThreadCount());
+        workspaces_pool = &workers;
+    }
+    return workspaces;
 }
 
 // ParallelDijkstraStrategy implementation
-std::vector<std::vector<double>> ParallelDijkstraStrategy::execute(Graph& graph) {
+void ParallelDijkstraStrategy::execute(Graph& graph, DistanceMatrix& dist) {
     int V = graph.getV();
 
-    // Створюємо копію оригінального графу
-    Graph originalGraph(V);
-    for (int u = 0; u < V; u++) {
-        for (const Edge& e : graph.getAdj()[u]) {
-            originalGraph.addEdge(u, e.dest, e.weight);
-        }
+    // Беллман-Форд з уявною вершиною і перетворення ваг, якщо їх ще немає в кеші графу
+    std::shared_ptr<ThreadPool> workers = getPool();
+    std::shared_ptr<const ReweightedGraph> reweighted =
+            graph.getReweighted(*workers, dijkstra_options.scc_decomposition);
+    if (!reweighted) {
+        std::cout << "Граф містить цикл з від'ємною вагою!" << std::endl;
+        dist.fill(INF);
+        return;
     }
+    const std::vector<double>& h = reweighted->h;
+
+    // Кожен воркер має власну пам'ять для Дейкстри, яка живе між запусками, потік, що викликав, - свою
+    std::shared_ptr<WorkerWorkspaces> workspaces = getWorkspaces(*workers);
+    DijkstraWorkspace caller_workspace;
+
+    // Паралельний запуск Дейкстри одним діапазоном джерел, кожне завдання пише лише свої рядки матриці
+    workers->parallelFor(0, V, [&](size_t src) {
+        DijkstraWorkspace& workspace = workspaces->get(workers->currentWorker(), caller_workspace);
+        reweightedDijkstra(*reweighted, static_cast<int>(src), workspace, dijkstra_options);
+        storeJohnsonRow(dist, static_cast<int>(src), static_cast<int>(src), workspace, h);
+    }, grain_size, schedule);
+}
 
-    // Створюємо новий граф з додатковою вершиною
-    Graph g(V + 1);
-    for (int u = 0; u < V; u++) {
-        for (const Edge& e : originalGraph.getAdj()[u]) {
-            g.addEdge(u, e.dest, e.weight);
-        }
+void ParallelDijkstraStrategy::executeSources(Graph& graph, const std::vector<int>& sources, DistanceMatrix& dist) {
+    std::shared_ptr<ThreadPool> workers = getPool();
+    std::shared_ptr<const ReweightedGraph> reweighted =
+            graph.getReweighted(*workers, dijkstra_options.scc_decomposition);
+    if (!reweighted) {
+        std::cout << "Граф містить цикл з від'ємною вагою!" << std::endl;
+        dist.fill(INF);
+        return;
     }
 
-    for (int v = 0; v < V; v++) {
-        g.addEdge(V, v, 0);
-    }
+    std::shared_ptr<WorkerWorkspaces> workspaces = getWorkspaces(*workers);
+    DijkstraWorkspace caller_workspace;
+    workers->parallelFor(0, sources.size(), [&](size_t i) {
+        DijkstraWorkspace& workspace = workspaces->get(workers->currentWorker(), caller_workspace);
+        reweightedDijkstra(*reweighted, sources[i], workspace, dijkstra_options);
+        storeJohnsonRow(dist, static_cast<int>(i), sources[i], workspace, reweighted->h);
+    }, grain_size, schedule);
+}
 
-    // Беллман-Форд
-    std::vector<double> h;
-    if (!g.bellmanFord(V, h)) {
+void ParallelDijkstraStrategy::executeToSink(Graph& graph, RowSink& sink) {
+    int V = graph.getV();
+    sink.begin(V, V);
+    std::shared_ptr<ThreadPool> workers = getPool();
+    std::shared_ptr<const ReweightedGraph> reweighted =
+            graph.getReweighted(*workers, dijkstra_options.scc_decomposition);
+    if (!reweighted) {
         std::cout << "Граф містить цикл з від'ємною вагою!" << std::endl;
-        return std::vector<std::vector<double>>(V, std::vector<double>(V, INF));
+        writeInfRows(sink, V);
+        sink.finish();
+        return;
     }
 
-    // Створюємо граф з перетвореними вагами
-    Graph transformedGraph(V);
-    for (int u = 0; u < V; u++) {
-        for (const Edge& e : originalGraph.getAdj()[u]) {
-            double newWeight = e.weight + h[u] - h[e.dest];
-            transformedGraph.addEdge(u, e.dest, newWeight);
-        }
+    // Джерела йдуть вікнами, тому рядки приходять у приймач майже по порядку
+    // і жоден рядок не випереджає перший незавершений більше ніж на вікно
+    size_t window = (workers->getThreadCount() + 1) * SINK_ROWS_PER_THREAD;
+    std::shared_ptr<WorkerWorkspaces> workspaces = getWorkspaces(*workers);
+    DijkstraWorkspace caller_workspace;
+    for (size_t first = 0; first < static_cast<size_t>(V); first += window) {
+        size_t last = std::min(static_cast<size_t>(V), first + window);
+        workers->parallelFor(first, last, [&](size_t src) {
+            DijkstraWorkspace& workspace = workspaces->get(workers->currentWorker(), caller_workspace);
+            reweightedDijkstra(*reweighted, static_cast<int>(src), workspace, dijkstra_options);
+            sink.writeRow(static_cast<int>(src), johnsonRow(static_cast<int>(src), workspace, reweighted->h));
+        }, 1, schedule);
     }
+    sink.finish();
+}
 
-    // Паралельний запуск Дейкстри
-    std::vector<std::vector<double>> dist(V, std::vector<double>(V, INF));
-    std::vector<std::future<void>> futures;
-
-    ThreadPool pool(thread_count);
-
-    for (int src = 0; src < V; src++) {
-        futures.push_back(pool.enqueue([&transformedGraph, src, &dist, &h, V]() {
-            transformedGraph.dijkstraWithFibHeap(src, dist[src]);
+void ParallelDijkstraStrategy::executeToFile(Graph& graph, const std::string& path, size_t memoryBudget,
+                                             DistancePrecision precision) {
+    int V = graph.getV();
+    DistanceFileWriter writer(path, V, V, precision);
+    std::shared_ptr<ThreadPool> workers = getPool();
+    std::shared_ptr<const ReweightedGraph> reweighted =
+            graph.getReweighted(*workers, dijkstra_options.scc_decomposition);
+    if (!reweighted) {
+        std::cout << "Граф містить цикл з від'ємною вагою!" << std::endl;
+    }
 
-            // Перетворення відстаней назад
-            for (int v = 0; v < V; v++) {
-                if (dist[src][v] != INF) {
-                    dist[src][v] = dist[src][v] - h[src] + h[v];
-                }
+    // Два буфери плиток: поки один записується у файл, пул заповнює інший
+    size_t row_bytes = std::max<size_t>(writer.getRowBytes(), 1);
+    int tile_rows = static_cast<int>(std::min<size_t>(std::max<size_t>(memoryBudget / (2 * row_bytes), 1), std::max(V, 1)));
+    std::vector<char> tiles[2];
+    tiles[0].resize(tile_rows * writer.getRowBytes());
+    tiles[1].resize(tile_rows * writer.getRowBytes());
+    TileWriter tile_writer(writer);
+    std::shared_ptr<WorkerWorkspaces> workspaces = getWorkspaces(*workers);
+    DijkstraWorkspace caller_workspace;
+    const std::vector<double> infinite(reweighted ? 0 : V, INF);
+
+    for (int first = 0, tile = 0; first < V; first += tile_rows, tile ^= 1) {
+        int count = std::min(tile_rows, V - first);
+        char* buffer = tiles[tile].data();
+        workers->parallelFor(0, count, [&](size_t i) {
+            int src = first + static_cast<int>(i);
+            const double* row = infinite.data();
+            if (reweighted) {
+                DijkstraWorkspace& workspace = workspaces->get(workers->currentWorker(), caller_workspace);
+                reweightedDijkstra(*reweighted, src, workspace, dijkstra_options);
+                row = johnsonRow(src, workspace, reweighted->h);
             }
-        }));
-    }
+            char* target = buffer + i * writer.getRowBytes();
+            if (precision == DistancePrecision::Float) {
+                float* converted = reinterpret_cast<float*>(target);
+                for (int v = 0; v < V; v++) converted[v] = static_cast<float>(row[v]);
+            } else {
+                std::copy(row, row + V, reinterpret_cast<double*>(target));
+            }
+        }, grain_size, schedule);
 
-    for (auto& future : futures) {
-        future.wait();
+        // Передача чекає на запис попередньої плитки, тому її буфер вільний для наступної
+        tile_writer.submit(first, count, buffer);
     }
-
-    return dist;
-}
\ No newline at end of file
+    tile_writer.finish();
+    writer.close();
+}
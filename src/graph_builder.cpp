@@ -0,0 +1,201 @@
+#include "../include/graph_builder.h"
+#include "../include/thread_pool.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <utility>
+
+namespace {
+    // Номери будівельників не повторюються, тому кеш потоку не сплутає знищений будівельник з новим
+    std::atomic<uint64_t> next_builder_id{1};
+
+    ///@brief the buffer used by the calling thread the last time
+    struct LocalBufferCache {
+        uint64_t builder = 0;
+        void* buffer = nullptr;
+    };
+    thread_local LocalBufferCache local_cache;
+
+    // Менше ребер на одне завдання не окупає розподіл між потоками
+    const size_t BUILD_GRAIN = 1 << 16;
+    // Не більше 1024 кошиків: потоки записів першого проходу ще вміщуються в кеш
+    const int BUCKET_BITS = 10;
+}
+
+GraphBuilder::GraphBuilder(int V, size_t threads)
+        : V(V), id(next_builder_id.fetch_add(1)),
+          thread_count(threads == 0 ? std::thread::hardware_concurrency() : threads) {}
+
+GraphBuilder::GraphBuilder(int V, std::shared_ptr<ThreadPool> sharedPool)
+        : V(V), id(next_builder_id.fetch_add(1)), pool(std::move(sharedPool)),
+          thread_count(pool->getThreadCount()) {}
+
+ThreadPool& GraphBuilder::getPool() {
+    if (!pool) {
+        pool = std::make_shared<ThreadPool>(std::max<size_t>(thread_count, 1));
+    }
+    return *pool;
+}
+
+GraphBuilder::Buffer& GraphBuilder::localBuffer() {
+    if (local_cache.builder == id) {
+        return *static_cast<Buffer*>(local_cache.buffer);
+    }
+
+    std::lock_guard<std::mutex> lock(buffers_mutex);
+    Buffer*& buffer = owners[std::this_thread::get_id()];
+    if (!buffer) {
+        buffers.push_back(std::make_unique<Buffer>());
+        buffer = buffers.back().get();
+    }
+    local_cache.builder = id;
+    local_cache.buffer = buffer;
+    return *buffer;
+}
+
+void GraphBuilder::reserve(size_t edges) {
+    Buffer& buffer = localBuffer();
+    buffer.src.reserve(buffer.src.size() + edges);
+    buffer.dst.reserve(buffer.dst.size() + edges);
+    buffer.weight.reserve(buffer.weight.size() + edges);
+}
+
+void GraphBuilder::addEdge(int src, int dest, double weight) {
+    addEdges(&src, &dest, &weight, 1);
+}
+
+void GraphBuilder::addEdges(const int* src, const int* dest, const double* weight, size_t count) {
+    Buffer& buffer = localBuffer();
+    for (size_t i = 0; i < count; i++) {
+        const char* error = nullptr;
+        if (src[i] < 0 || src[i] >= V || dest[i] < 0 || dest[i] >= V) {
+            error = "vertex is out of range";
+        } else if (!std::isfinite(weight[i])) {
+            error = "weight is not a finite number";
+        }
+        if (error) {
+            buffer.rejected++;
+            if (buffer.errors.size() < BuildReport::MAX_REPORTED_ERRORS) {
+                buffer.errors.push_back("edge " + std::to_string(src[i]) + " -> " + std::to_string(dest[i]) + ": " + error);
+            }
+            continue;
+        }
+        buffer.src.push_back(src[i]);
+        buffer.dst.push_back(dest[i]);
+        buffer.weight.push_back(weight[i]);
+    }
+}
+
+Graph GraphBuilder::build() {
+    std::vector<std::unique_ptr<Buffer>> taken;
+    {
+        std::lock_guard<std::mutex> lock(buffers_mutex);
+        taken = std::move(buffers);
+        buffers.clear();
+        owners.clear();
+    }
+    // Кеш потоків більше не повинен вказувати на забрані буфери
+    id = next_builder_id.fetch_add(1);
+
+    report = BuildReport();
+    // Завдання - шматки буферів приблизно однакового розміру
+    struct Piece {
+        const Buffer* buffer;
+        size_t begin;
+        size_t end;
+    };
+    std::vector<Piece> pieces;
+    for (const auto& buffer : taken) {
+        report.rejected += buffer->rejected;
+        for (const std::string& error : buffer->errors) {
+            if (report.errors.size() < BuildReport::MAX_REPORTED_ERRORS) report.errors.push_back(error);
+        }
+        size_t size = buffer->src.size();
+        report.edges += size;
+        for (size_t begin = 0; begin < size; begin += BUILD_GRAIN) {
+            pieces.push_back({buffer.get(), begin, std::min(size, begin + BUILD_GRAIN)});
+        }
+    }
+
+    bool parallel = thread_count > 1 && pieces.size() > 1;
+    auto run = [&](size_t count, auto&& body) {
+        if (parallel) {
+            getPool().parallelFor(0, count, body, 1);
+        } else {
+            for (size_t i = 0; i < count; i++) body(i);
+        }
+    };
+
+    // Сортування підрахунком у два проходи без атомарних операцій. Спочатку ребра розкладаються
+    // за старшими бітами початкової вершини в не більше ніж 2^BUCKET_BITS кошиків, потім кожен кошик
+    // розкладається за вершинами окремо: його лічильники поміщаються в кеш, а записи не розкидані по всьому масиву
+    int shift = 0;
+    while ((static_cast<size_t>(V) >> shift) >= (size_t(1) << BUCKET_BITS)) shift++;
+    size_t buckets = V == 0 ? 0 : (static_cast<size_t>(V - 1) >> shift) + 1;
+
+    // counts[p * buckets + b] - кількість ребер шматка p у кошику b, потім місце першого з них
+    std::vector<size_t> counts(pieces.size() * buckets, 0);
+    run(pieces.size(), [&](size_t p) {
+        const Piece& piece = pieces[p];
+        size_t* local = counts.data() + p * buckets;
+        for (size_t i = piece.begin; i < piece.end; i++) {
+            local[piece.buffer->src[i] >> shift]++;
+        }
+    });
+
+    // Кошики йдуть підряд, всередині кошика шматки у своєму порядку, тому розкладання стабільне
+    std::vector<size_t> bucket_begin(buckets + 1, 0);
+    size_t position = 0;
+    for (size_t b = 0; b < buckets; b++) {
+        bucket_begin[b] = position;
+        for (size_t p = 0; p < pieces.size(); p++) {
+            size_t count = counts[p * buckets + b];
+            counts[p * buckets + b] = position;
+            position += count;
+        }
+    }
+    bucket_begin[buckets] = position;
+
+    std::vector<int> bucket_src(report.edges);
+    std::vector<int> bucket_dst(report.edges);
+    std::vector<double> bucket_weight(report.edges);
+    run(pieces.size(), [&](size_t p) {
+        const Piece& piece = pieces[p];
+        size_t* next = counts.data() + p * buckets;
+        for (size_t i = piece.begin; i < piece.end; i++) {
+            size_t slot = next[piece.buffer->src[i] >> shift]++;
+            bucket_src[slot] = piece.buffer->src[i];
+            bucket_dst[slot] = piece.buffer->dst[i];
+            bucket_weight[slot] = piece.buffer->weight[i];
+        }
+    });
+    taken.clear();
+
+    std::vector<size_t> offsets(V + 1, 0);
+    std::vector<int> targets(report.edges);
+    std::vector<double> weights(report.edges);
+    offsets[V] = report.edges;
+    run(buckets, [&](size_t b) {
+        int first = static_cast<int>(b << shift);
+        int last = std::min(V, static_cast<int>((b + 1) << shift));
+        thread_local std::vector<size_t> next;
+        next.assign(last - first, 0);
+        for (size_t i = bucket_begin[b]; i < bucket_begin[b + 1]; i++) {
+            next[bucket_src[i] - first]++;
+        }
+        size_t slot = bucket_begin[b];
+        for (int u = first; u < last; u++) {
+            offsets[u] = slot;
+            size_t degree = next[u - first];
+            next[u - first] = slot;
+            slot += degree;
+        }
+        for (size_t i = bucket_begin[b]; i < bucket_begin[b + 1]; i++) {
+            size_t target = next[bucket_src[i] - first]++;
+            targets[target] = bucket_dst[i];
+            weights[target] = bucket_weight[i];
+        }
+    });
+
+    return Graph(std::make_shared<const CSRGraph>(V, std::move(offsets), std::move(targets), std::move(weights)));
+}
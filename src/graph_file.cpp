@@ -0,0 +1,181 @@
+#include "../include/graph_file.h"
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define JOHNSON_HAS_MMAP 1
+#endif
+
+namespace {
+    const char MAGIC[8] = {'J', 'G', 'R', 'A', 'P', 'H', 0, 0};
+    const uint32_t FORMAT_VERSION = 1;
+    const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+    // Масиви файлу використовуються напряму, тому типи мають збігатися з форматом
+    static_assert(sizeof(size_t) == sizeof(uint64_t), "offsets are stored as 64-bit values");
+    static_assert(sizeof(int) == sizeof(int32_t), "targets are stored as 32-bit values");
+    static_assert(sizeof(GraphFileHeader) == 32, "the header must not have padding");
+
+    ///@brief positions of the arrays inside the file
+    struct Layout {
+        size_t offsets;
+        size_t targets;
+        size_t weights;
+        size_t total;
+    };
+
+    Layout layoutFor(uint64_t vertices, uint64_t edges) {
+        Layout layout;
+        layout.offsets = sizeof(GraphFileHeader);
+        layout.targets = layout.offsets + (vertices + 1) * sizeof(uint64_t);
+        size_t targets_end = layout.targets + edges * sizeof(int32_t);
+        layout.weights = (targets_end + 7) / 8 * 8;
+        layout.total = layout.weights + edges * sizeof(double);
+        return layout;
+    }
+
+    ///@brief checking the header and the size of the file
+    Layout validate(const GraphFileHeader& header, size_t file_size, const std::string& path) {
+        if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+            throw std::runtime_error(path + " is not a graph file");
+        }
+        if (header.byte_order != BYTE_ORDER_MARK) {
+            throw std::runtime_error(path + " was written on a machine with a different byte order");
+        }
+        if (header.format_version != FORMAT_VERSION) {
+            throw std::runtime_error(path + " has unsupported format version " + std::to_string(header.format_version));
+        }
+        if (header.vertices > static_cast<uint64_t>(std::numeric_limits<int>::max())) {
+            throw std::runtime_error(path + " has too many vertices");
+        }
+        // Розміри масивів обмежуються розміром файлу до множення, тому розрахунок розташування не переповнюється
+        if (header.vertices + 1 > file_size / sizeof(uint64_t) ||
+            header.edges > file_size / (sizeof(int32_t) + sizeof(double))) {
+            throw std::runtime_error(path + " is truncated");
+        }
+        Layout layout = layoutFor(header.vertices, header.edges);
+        if (file_size < layout.total) {
+            throw std::runtime_error(path + " is truncated");
+        }
+        return layout;
+    }
+
+    ///@brief checking that the offsets and targets describe a valid graph, so the solver never reads out of bounds
+    void validateArrays(const size_t* offsets, const int* targets, uint64_t vertices, uint64_t edges,
+                        const std::string& path) {
+        if (offsets[0] != 0 || offsets[vertices] != edges) {
+            throw std::runtime_error(path + " has corrupted offsets");
+        }
+        for (uint64_t v = 0; v < vertices; v++) {
+            if (offsets[v] > offsets[v + 1]) {
+                throw std::runtime_error(path + " has corrupted offsets");
+            }
+        }
+        for (uint64_t i = 0; i < edges; i++) {
+            if (targets[i] < 0 || static_cast<uint64_t>(targets[i]) >= vertices) {
+                throw std::runtime_error(path + " has an edge to a missing vertex");
+            }
+        }
+    }
+}
+
+void writeGraphFile(const std::string& path, const CSRGraph& g) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Cannot open " + path + " for writing");
+    }
+
+    GraphFileHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.format_version = FORMAT_VERSION;
+    header.byte_order = BYTE_ORDER_MARK;
+    header.vertices = static_cast<uint64_t>(g.getV());
+    header.edges = g.getEdgeCount();
+    Layout layout = layoutFor(header.vertices, header.edges);
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(g.getOffsets()), (header.vertices + 1) * sizeof(uint64_t));
+    out.write(reinterpret_cast<const char*>(g.getTargets()), header.edges * sizeof(int32_t));
+    const char padding[8] = {};
+    out.write(padding, layout.weights - (layout.targets + header.edges * sizeof(int32_t)));
+    out.write(reinterpret_cast<const char*>(g.getWeights()), header.edges * sizeof(double));
+
+    if (!out) {
+        throw std::runtime_error("Failed to write " + path);
+    }
+}
+
+std::shared_ptr<const CSRGraph> mapGraphFile(const std::string& path) {
+#ifdef JOHNSON_HAS_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open " + path);
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(GraphFileHeader)) {
+        ::close(fd);
+        throw std::runtime_error(path + " is not a graph file");
+    }
+    size_t size = static_cast<size_t>(info.st_size);
+    void* address = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // Відображення лишається дійсним і після закриття дескриптора
+    ::close(fd);
+    if (address == MAP_FAILED) {
+        throw std::runtime_error("Cannot map " + path);
+    }
+
+    // Відображення звільняється разом з останньою копією графу
+    std::shared_ptr<const void> mapping(address, [size](const void* p) {
+        ::munmap(const_cast<void*>(p), size);
+    });
+
+    const auto* base = static_cast<const unsigned char*>(address);
+    GraphFileHeader header;
+    std::memcpy(&header, base, sizeof(header));
+    Layout layout = validate(header, size, path);
+
+    const auto* offsets = reinterpret_cast<const size_t*>(base + layout.offsets);
+    const auto* targets = reinterpret_cast<const int*>(base + layout.targets);
+    const auto* weights = reinterpret_cast<const double*>(base + layout.weights);
+    validateArrays(offsets, targets, header.vertices, header.edges, path);
+
+    return std::make_shared<const CSRGraph>(static_cast<int>(header.vertices), header.edges,
+                                            offsets, targets, weights, std::move(mapping));
+#else
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) {
+        throw std::runtime_error("Cannot open " + path);
+    }
+    size_t size = static_cast<size_t>(in.tellg());
+    in.seekg(0);
+    GraphFileHeader header{};
+    if (size < sizeof(header) || !in.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        throw std::runtime_error(path + " is not a graph file");
+    }
+    Layout layout = validate(header, size, path);
+
+    std::vector<size_t> offsets(header.vertices + 1);
+    std::vector<int> targets(header.edges);
+    std::vector<double> weights(header.edges);
+    in.seekg(layout.offsets);
+    in.read(reinterpret_cast<char*>(offsets.data()), offsets.size() * sizeof(size_t));
+    in.seekg(layout.targets);
+    in.read(reinterpret_cast<char*>(targets.data()), targets.size() * sizeof(int));
+    in.seekg(layout.weights);
+    in.read(reinterpret_cast<char*>(weights.data()), weights.size() * sizeof(double));
+    if (!in) {
+        throw std::runtime_error("Failed to read " + path);
+    }
+    validateArrays(offsets.data(), targets.data(), header.vertices, header.edges, path);
+
+    return std::make_shared<const CSRGraph>(static_cast<int>(header.vertices), std::move(offsets),
+                                            std::move(targets), std::move(weights));
+#endif
+}
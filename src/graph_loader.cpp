@@ -0,0 +1,495 @@
+#include "../include/graph_loader.h"
+#include "../include/thread_pool.h"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define JOHNSON_HAS_MMAP 1
+#endif
+
+namespace {
+    ///@brief the settings read from the header of the file, shared by all chunks
+    struct Header {
+        GraphFormat format = GraphFormat::Csv;
+        long long vertices = -1;  // -1 для CSV: кількість визначається за найбільшим номером
+        int base = 0;             // номер першої вершини у файлі
+        bool pattern = false;     // Matrix Market без ваг, кожне ребро має вагу 1
+        int mirror = 0;           // 1 для symmetric, -1 для skew-symmetric: кожне ребро додається і у зворотному напрямку
+        bool compact = false;     // лише без оголошеної кількості: номери перенумеровуються в 0..n-1 після розбору
+    };
+
+    // Без оголошеної кількості вершин більша кількість, ніж тут, вважається помилкою у номерах
+    const long long MIN_INFERRED_VERTICES = 1 << 20;
+    const long long INFERRED_VERTICES_PER_EDGE = 4;
+
+    ///@brief a piece of the body parsed by one task
+    struct Chunk {
+        const char* begin;
+        const char* end;
+        std::vector<int> src;
+        std::vector<int> dst;
+        std::vector<double> weight;
+        std::vector<long long> ids;  // у режимі compact: пари вихідних номерів (from, to) замість src і dst
+        size_t lines = 0;
+        size_t skipped = 0;
+        std::vector<std::pair<size_t, const char*>> errors;  // номер рядка в межах шматка і повідомлення
+        long long max_vertex = -1;
+    };
+
+    ///@brief the next line of [p, end) without the line break, p is moved to the following line
+    std::pair<const char*, const char*> nextLine(const char*& p, const char* end) {
+        const char* begin = p;
+        const char* newline = static_cast<const char*>(std::memchr(p, '\n', end - p));
+        const char* line_end = newline ? newline : end;
+        p = newline ? newline + 1 : end;
+        if (line_end > begin && line_end[-1] == '\r') line_end--;
+        return {begin, line_end};
+    }
+
+    void skipSpaces(const char*& p, const char* end) {
+        while (p < end && (*p == ' ' || *p == '\t')) p++;
+    }
+
+    bool readInteger(const char*& p, const char* end, long long& value) {
+        skipSpaces(p, end);
+        if (p < end && *p == '+') p++;
+        auto result = std::from_chars(p, end, value);
+        if (result.ec != std::errc()) return false;
+        p = result.ptr;
+        return true;
+    }
+
+    bool readWeight(const char*& p, const char* end, double& value) {
+        skipSpaces(p, end);
+        if (p < end && *p == '+') p++;
+        auto result = std::from_chars(p, end, value);
+        if (result.ec != std::errc()) return false;
+        p = result.ptr;
+        return true;
+    }
+
+    bool readSeparator(const char*& p, const char* end) {
+        skipSpaces(p, end);
+        if (p == end || *p != ',') return false;
+        p++;
+        return true;
+    }
+
+    bool atEnd(const char*& p, const char* end) {
+        skipSpaces(p, end);
+        return p == end;
+    }
+
+    ///@brief checking a vertex id and converting it to the 0-based one
+    const char* toVertex(const Header& header, long long id, int& vertex) {
+        id -= header.base;
+        if (id < 0 || id >= std::numeric_limits<int>::max() || (header.vertices >= 0 && id >= header.vertices)) {
+            return "vertex is out of range";
+        }
+        vertex = static_cast<int>(id);
+        return nullptr;
+    }
+
+    ///@brief parsing one line of the body into the chunk
+    ///@return nullptr on success or the description of the error
+    const char* parseLine(const Header& header, const char* p, const char* end, Chunk& chunk) {
+        skipSpaces(p, end);
+        if (p == end) return nullptr;
+
+        long long from = 0, to = 0;
+        double weight = 1.0;
+        switch (header.format) {
+            case GraphFormat::Dimacs:
+                if (*p == 'c') return nullptr;
+                if (*p == 'p') return "repeated problem line";
+                if (*p != 'a') return "unknown line type";
+                p++;
+                if (!readInteger(p, end, from) || !readInteger(p, end, to)) return "expected two vertex ids";
+                if (!readWeight(p, end, weight)) return "expected a weight";
+                break;
+            case GraphFormat::MatrixMarket:
+                if (*p == '%') return nullptr;
+                if (!readInteger(p, end, from) || !readInteger(p, end, to)) return "expected two vertex ids";
+                if (!header.pattern && !readWeight(p, end, weight)) return "expected a weight";
+                break;
+            default:
+                if (*p == '#') return nullptr;
+                if (!readInteger(p, end, from) || !readSeparator(p, end) || !readInteger(p, end, to)) {
+                    return "expected two vertex ids";
+                }
+                if (!readSeparator(p, end) || !readWeight(p, end, weight)) return "expected a weight";
+                break;
+        }
+        if (!atEnd(p, end)) return "unexpected text after the edge";
+        if (!std::isfinite(weight)) return "weight is not a finite number";
+
+        if (header.compact) {
+            // Справжні номери відомі лише після розбору всіх шматків
+            chunk.ids.push_back(from);
+            chunk.ids.push_back(to);
+            chunk.weight.push_back(weight);
+            return nullptr;
+        }
+        int u = 0, v = 0;
+        if (const char* error = toVertex(header, from, u)) return error;
+        if (const char* error = toVertex(header, to, v)) return error;
+
+        chunk.src.push_back(u);
+        chunk.dst.push_back(v);
+        chunk.weight.push_back(weight);
+        if (header.mirror != 0 && u != v) {
+            chunk.src.push_back(v);
+            chunk.dst.push_back(u);
+            chunk.weight.push_back(header.mirror * weight);
+        }
+        chunk.max_vertex = std::max<long long>(chunk.max_vertex, std::max(u, v));
+        return nullptr;
+    }
+
+    void parseChunk(const Header& header, Chunk& chunk) {
+        // Запас на випадок рядків середньої довжини, щоб уникнути більшості перевиділень
+        size_t guess = (chunk.end - chunk.begin) / 16;
+        if (header.compact) {
+            chunk.ids.reserve(2 * guess);
+        } else {
+            chunk.src.reserve(guess);
+            chunk.dst.reserve(guess);
+        }
+        chunk.weight.reserve(guess);
+
+        const char* p = chunk.begin;
+        while (p < chunk.end) {
+            auto line = nextLine(p, chunk.end);
+            chunk.lines++;
+            if (const char* error = parseLine(header, line.first, line.second, chunk)) {
+                chunk.skipped++;
+                if (chunk.errors.size() < LoadReport::MAX_REPORTED_ERRORS) {
+                    chunk.errors.emplace_back(chunk.lines, error);
+                }
+            }
+        }
+    }
+
+    std::string lowercase(std::string word) {
+        std::transform(word.begin(), word.end(), word.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return word;
+    }
+
+    ///@brief the format guessed from the first meaningful line of the text
+    GraphFormat detectFormat(const char* p, const char* end) {
+        static const char BANNER[] = "%%MatrixMarket";
+        const size_t banner_size = sizeof(BANNER) - 1;
+        if (static_cast<size_t>(end - p) >= banner_size && std::memcmp(p, BANNER, banner_size) == 0) {
+            return GraphFormat::MatrixMarket;
+        }
+        while (p < end) {
+            auto line = nextLine(p, end);
+            const char* q = line.first;
+            skipSpaces(q, line.second);
+            if (q == line.second) continue;
+            bool dimacs = (*q == 'c' || *q == 'p' || *q == 'a') &&
+                          (q + 1 == line.second || q[1] == ' ' || q[1] == '\t');
+            return dimacs ? GraphFormat::Dimacs : GraphFormat::Csv;
+        }
+        return GraphFormat::Csv;
+    }
+
+    GraphFormat formatFromExtension(const std::string& path) {
+        size_t dot = path.find_last_of('.');
+        if (dot == std::string::npos || path.find_first_of("/\\", dot) != std::string::npos) {
+            return GraphFormat::Auto;
+        }
+        std::string extension = lowercase(path.substr(dot + 1));
+        if (extension == "gr") return GraphFormat::Dimacs;
+        if (extension == "csv") return GraphFormat::Csv;
+        if (extension == "mtx") return GraphFormat::MatrixMarket;
+        return GraphFormat::Auto;
+    }
+
+    /**
+     * @brief reading the header lines which must be parsed before the body can be split
+     * @param p the beginning of the text
+     * @param end the end of the text
+     * @param header the settings of the file, is used by reference
+     * @param lines the number of lines consumed, is used by reference
+     * @return the position where the edges begin
+     */
+    const char* readHeader(const char* p, const char* end, Header& header, size_t& lines) {
+
+        // У CSV заголовка немає: рядок з назвами стовпців не розбирається як ребро і потрапляє у звіт
+        if (header.format == GraphFormat::Csv) return p;
+
+        if (header.format == GraphFormat::Dimacs) {
+            header.base = 1;
+            while (p < end) {
+                auto line = nextLine(p, end);
+                lines++;
+                const char* q = line.first;
+                skipSpaces(q, line.second);
+                if (q == line.second || *q == 'c') continue;
+                if (*q != 'p') break;
+                q++;
+                skipSpaces(q, line.second);
+                while (q < line.second && *q != ' ' && *q != '\t') q++;  // назва задачі, зазвичай "sp"
+                long long vertices = 0, edges = 0;
+                if (!readInteger(q, line.second, vertices) || !readInteger(q, line.second, edges) ||
+                    !atEnd(q, line.second) || vertices < 0 || edges < 0) {
+                    throw std::runtime_error("Invalid DIMACS problem line at line " + std::to_string(lines));
+                }
+                header.vertices = vertices;
+                return p;
+            }
+            throw std::runtime_error("DIMACS problem line is missing");
+        }
+
+        // Matrix Market
+        header.base = 1;
+        auto banner = nextLine(p, end);
+        lines++;
+        std::istringstream words(std::string(banner.first, banner.second));
+        std::string magic, object, layout, field, symmetry;
+        words >> magic >> object >> layout >> field >> symmetry;
+        if (magic != "%%MatrixMarket") {
+            throw std::runtime_error("Matrix Market banner is missing");
+        }
+        object = lowercase(object);
+        layout = lowercase(layout);
+        field = lowercase(field);
+        symmetry = lowercase(symmetry);
+        if (object != "matrix" || layout != "coordinate") {
+            throw std::runtime_error("Only coordinate Matrix Market matrices are supported");
+        }
+        if (field == "pattern") {
+            header.pattern = true;
+        } else if (field != "real" && field != "integer" && field != "double") {
+            throw std::runtime_error("Unsupported Matrix Market field: " + field);
+        }
+        if (symmetry == "symmetric") {
+            header.mirror = 1;
+        } else if (symmetry == "skew-symmetric") {
+            header.mirror = -1;
+        } else if (symmetry != "general") {
+            throw std::runtime_error("Unsupported Matrix Market symmetry: " + symmetry);
+        }
+
+        while (p < end) {
+            auto line = nextLine(p, end);
+            lines++;
+            const char* q = line.first;
+            skipSpaces(q, line.second);
+            if (q == line.second || *q == '%') continue;
+            long long rows = 0, cols = 0, entries = 0;
+            if (!readInteger(q, line.second, rows) || !readInteger(q, line.second, cols) ||
+                !readInteger(q, line.second, entries) || !atEnd(q, line.second) ||
+                rows < 0 || cols < 0 || entries < 0) {
+                throw std::runtime_error("Invalid Matrix Market size line at line " + std::to_string(lines));
+            }
+            header.vertices = std::max(rows, cols);
+            return p;
+        }
+        throw std::runtime_error("Matrix Market size line is missing");
+    }
+}
+
+const char* graphFormatName(GraphFormat format) {
+    switch (format) {
+        case GraphFormat::Auto: return "Auto";
+        case GraphFormat::Dimacs: return "DIMACS";
+        case GraphFormat::Csv: return "CSV";
+        case GraphFormat::MatrixMarket: return "MatrixMarket";
+    }
+    return "Unknown";
+}
+
+GraphLoader::GraphLoader(size_t threads)
+        : thread_count(threads == 0 ? std::thread::hardware_concurrency() : threads) {}
+
+GraphLoader::GraphLoader(std::shared_ptr<ThreadPool> sharedPool)
+        : pool(std::move(sharedPool)), thread_count(pool->getThreadCount()) {}
+
+ThreadPool& GraphLoader::getPool() {
+    if (!pool) {
+        pool = std::make_shared<ThreadPool>(std::max<size_t>(thread_count, 1));
+    }
+    return *pool;
+}
+
+void GraphLoader::setChunkSize(size_t bytes) {
+    chunk_size = std::max<size_t>(bytes, 1);
+}
+
+Graph GraphLoader::load(const std::string& path, GraphFormat format) {
+    if (format == GraphFormat::Auto) {
+        format = formatFromExtension(path);
+    }
+#ifdef JOHNSON_HAS_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open " + path);
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Failed to read " + path);
+    }
+    size_t size = static_cast<size_t>(info.st_size);
+    if (size == 0) {
+        ::close(fd);
+        return parse(std::string(), format);
+    }
+    // Текст розбирається прямо у відображених сторінках, без копії всього файлу в пам'ять
+    void* address = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (address == MAP_FAILED) {
+        throw std::runtime_error("Cannot map " + path);
+    }
+    std::shared_ptr<const void> mapping(address, [size](const void* p) {
+        ::munmap(const_cast<void*>(p), size);
+    });
+    const char* text = static_cast<const char*>(address);
+    return parseRange(text, text + size, format);
+#else
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) {
+        throw std::runtime_error("Cannot open " + path);
+    }
+    std::string text(static_cast<size_t>(in.tellg()), '\0');
+    in.seekg(0);
+    if (!in.read(&text[0], static_cast<std::streamsize>(text.size()))) {
+        throw std::runtime_error("Failed to read " + path);
+    }
+    return parse(text, format);
+#endif
+}
+
+Graph GraphLoader::parse(const std::string& text, GraphFormat format) {
+    return parseRange(text.data(), text.data() + text.size(), format);
+}
+
+Graph GraphLoader::parseRange(const char* begin, const char* end, GraphFormat format) {
+    last_report = LoadReport();
+    Header header;
+    header.format = format == GraphFormat::Auto ? detectFormat(begin, end) : format;
+    size_t header_lines = 0;
+    const char* body = readHeader(begin, end, header, header_lines);
+    header.compact = compact_ids && header.vertices < 0;
+    if (header.vertices > std::numeric_limits<int>::max()) {
+        throw std::runtime_error("Too many vertices: " + std::to_string(header.vertices));
+    }
+
+    // Шматки закінчуються на межі рядка, щоб кожен рядок розбирав рівно один потік
+    std::vector<Chunk> chunks;
+    for (const char* p = body; p < end;) {
+        const char* stop = end;
+        if (static_cast<size_t>(end - p) > chunk_size) {
+            const char* newline = static_cast<const char*>(std::memchr(p + chunk_size, '\n', end - p - chunk_size));
+            stop = newline ? newline + 1 : end;
+        }
+        Chunk chunk;
+        chunk.begin = p;
+        chunk.end = stop;
+        chunks.push_back(std::move(chunk));
+        p = stop;
+    }
+
+    if (chunks.size() > 1 && thread_count > 1) {
+        getPool().parallelFor(0, chunks.size(), [&](size_t i) { parseChunk(header, chunks[i]); }, 1);
+    } else {
+        for (Chunk& chunk : chunks) parseChunk(header, chunk);
+    }
+
+    // Звіт: номери рядків шматків зсуваються на кількість рядків перед ними
+    last_report.format = header.format;
+    last_report.lines = header_lines;
+    long long max_vertex = -1;
+    size_t edges = 0;
+    for (const Chunk& chunk : chunks) {
+        for (const auto& error : chunk.errors) {
+            if (last_report.errors.size() < LoadReport::MAX_REPORTED_ERRORS) {
+                last_report.errors.push_back("line " + std::to_string(last_report.lines + error.first) + ": " + error.second);
+            }
+        }
+        last_report.lines += chunk.lines;
+        last_report.skipped += chunk.skipped;
+        max_vertex = std::max(max_vertex, chunk.max_vertex);
+        edges += chunk.weight.size();
+    }
+    last_report.edges = edges;
+
+    long long vertices = header.vertices;
+    if (header.compact) {
+        // Вершини нумеруються за зростанням вихідних номерів, номер у файлі - last_report.vertex_ids[v]
+        std::vector<long long>& ids = last_report.vertex_ids;
+        ids.reserve(2 * edges);
+        for (const Chunk& chunk : chunks) {
+            ids.insert(ids.end(), chunk.ids.begin(), chunk.ids.end());
+        }
+        std::sort(ids.begin(), ids.end());
+        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+        ids.shrink_to_fit();
+        if (ids.size() >= static_cast<size_t>(std::numeric_limits<int>::max())) {
+            throw std::runtime_error("Too many vertices: " + std::to_string(ids.size()));
+        }
+        auto renumber = [&ids](Chunk& chunk) {
+            size_t count = chunk.weight.size();
+            chunk.src.resize(count);
+            chunk.dst.resize(count);
+            for (size_t i = 0; i < count; i++) {
+                chunk.src[i] = static_cast<int>(std::lower_bound(ids.begin(), ids.end(), chunk.ids[2 * i]) - ids.begin());
+                chunk.dst[i] = static_cast<int>(std::lower_bound(ids.begin(), ids.end(), chunk.ids[2 * i + 1]) - ids.begin());
+            }
+            std::vector<long long>().swap(chunk.ids);
+        };
+        if (chunks.size() > 1 && thread_count > 1) {
+            getPool().parallelFor(0, chunks.size(), [&](size_t i) { renumber(chunks[i]); }, 1);
+        } else {
+            for (Chunk& chunk : chunks) renumber(chunk);
+        }
+        vertices = static_cast<long long>(ids.size());
+    } else if (vertices < 0) {
+        // Один великий номер не повинен виділяти пам'ять на мільярди порожніх вершин
+        vertices = max_vertex + 1;
+        if (vertices > std::max(MIN_INFERRED_VERTICES, INFERRED_VERTICES_PER_EDGE * static_cast<long long>(edges))) {
+            throw std::runtime_error("Vertex id " + std::to_string(max_vertex) + " needs " + std::to_string(vertices) +
+                                     " vertices for " + std::to_string(edges) +
+                                     " edges; use GraphLoader::setCompactIds(true) to renumber sparse ids");
+        }
+    }
+
+    // Сортування підрахунком у CSR: степені, зсуви, потім ребра в порядку файлу
+    int V = static_cast<int>(vertices);
+    std::vector<size_t> offsets(V + 1, 0);
+    for (const Chunk& chunk : chunks) {
+        for (int u : chunk.src) offsets[u + 1]++;
+    }
+    for (int u = 0; u < V; u++) {
+        offsets[u + 1] += offsets[u];
+    }
+    std::vector<size_t> position(offsets.begin(), offsets.end() - 1);
+    std::vector<int> targets(edges);
+    std::vector<double> weights(edges);
+    for (Chunk& chunk : chunks) {
+        for (size_t i = 0; i < chunk.src.size(); i++) {
+            size_t slot = position[chunk.src[i]]++;
+            targets[slot] = chunk.dst[i];
+            weights[slot] = chunk.weight[i];
+        }
+        // Пам'ять шматка більше не потрібна
+        chunk = Chunk{};
+    }
+
+    return Graph(std::make_shared<const CSRGraph>(V, std::move(offsets), std::move(targets), std::move(weights)));
+}
@@ -0,0 +1,219 @@
+#include "../include/indexed_fibonacci_heap.h"
+#include "../include/constants.h"
+
+namespace {
+    // Степінь вузла не перевищує log_phi(n) < 64 для будь-якого int n
+    const int MAX_DEGREE = 64;
+}
+
+IndexedFibonacciHeap::IndexedFibonacciHeap(int capacity)
+        : nodes(capacity), degree_table(MAX_DEGREE, -1), min(-1), n(0) {
+    for (Node& node : nodes) {
+        node.in_heap = false;
+    }
+    roots.reserve(capacity);
+}
+
+void IndexedFibonacciHeap::addRoot(int x) {
+    Node& node = nodes[x];
+    node.parent = -1;
+    node.mark = false;
+
+    if (min == -1) {
+        node.left = x;
+        node.right = x;
+        min = x;
+        return;
+    }
+    node.right = min;
+    node.left = nodes[min].left;
+    nodes[nodes[min].left].right = x;
+    nodes[min].left = x;
+
+    if (node.key < nodes[min].key) {
+        min = x;
+    }
+}
+
+void IndexedFibonacciHeap::link(int y, int x) {
+    // Видаляємо y з кореневого списку
+    nodes[nodes[y].left].right = nodes[y].right;
+    nodes[nodes[y].right].left = nodes[y].left;
+
+    // Робимо y дочірнім для x
+    int child = nodes[x].child;
+    if (child == -1) {
+        nodes[x].child = y;
+        nodes[y].right = y;
+        nodes[y].left = y;
+    } else {
+        nodes[y].right = child;
+        nodes[y].left = nodes[child].left;
+        nodes[nodes[child].left].right = y;
+        nodes[child].left = y;
+    }
+
+    nodes[y].parent = x;
+    nodes[x].degree++;
+    nodes[y].mark = false;
+}
+
+void IndexedFibonacciHeap::consolidate() {
+    if (min == -1) return;
+
+    // Знімок кореневого списку, буфер зарезервовано в конструкторі
+    roots.clear();
+    int current = min;
+    do {
+        roots.push_back(current);
+        current = nodes[current].right;
+    } while (current != min);
+
+    int max_used = 0;
+    for (int root : roots) {
+        int x = root;
+        int d = nodes[x].degree;
+
+        // Доки існує дерево того ж степеня
+        while (degree_table[d] != -1) {
+            int y = degree_table[d];
+            if (nodes[x].key > nodes[y].key) {
+                std::swap(x, y);
+            }
+
+            link(y, x);
+            degree_table[d] = -1;
+            d++;
+        }
+
+        degree_table[d] = x;
+        if (d > max_used) max_used = d;
+    }
+
+    // Перебудовуємо список коренів і очищаємо таблицю для наступного виклику
+    min = -1;
+    for (int i = 0; i <= max_used; i++) {
+        if (degree_table[i] != -1) {
+            addRoot(degree_table[i]);
+            degree_table[i] = -1;
+        }
+    }
+}
+
+void IndexedFibonacciHeap::cut(int x, int y) {
+    // Видаляємо x з дочірнього списку y
+    if (nodes[x].right == x) {
+        nodes[y].child = -1;
+    } else {
+        nodes[nodes[x].right].left = nodes[x].left;
+        nodes[nodes[x].left].right = nodes[x].right;
+        if (nodes[y].child == x) {
+            nodes[y].child = nodes[x].right;
+        }
+    }
+
+    nodes[y].degree--;
+
+    // Додаємо x до кореневого списку
+    addRoot(x);
+}
+
+void IndexedFibonacciHeap::cascadingCut(int y) {
+    int z = nodes[y].parent;
+    while (z != -1) {
+        if (!nodes[y].mark) {
+            nodes[y].mark = true;
+            return;
+        }
+        cut(y, z);
+        y = z;
+        z = nodes[y].parent;
+    }
+}
+
+void IndexedFibonacciHeap::insert(int vertex, double key) {
+    Node& node = nodes[vertex];
+    node.key = key;
+    node.child = -1;
+    node.degree = 0;
+    node.in_heap = true;
+
+    addRoot(vertex);
+
+    n++;
+}
+
+void IndexedFibonacciHeap::decreaseKey(int vertex, double newKey) {
+    Node& x = nodes[vertex];
+    if (newKey > x.key) {
+        return;  // Новий ключ більший, нічого не робимо
+    }
+
+    x.key = newKey;
+    int y = x.parent;
+
+    if (y != -1 && x.key < nodes[y].key) {
+        cut(vertex, y);
+        cascadingCut(y);
+    }
+
+    if (x.key < nodes[min].key) {
+        min = vertex;
+    }
+}
+
+std::pair<int, double> IndexedFibonacciHeap::extractMin() {
+    int z = min;
+    if (z == -1) {
+        return {-1, INF};
+    }
+
+    // Додаємо всіх дітей z до кореневого списку
+    int child = nodes[z].child;
+    if (child != -1) {
+        int temp = child;
+        do {
+            int next = nodes[temp].right;
+            addRoot(temp);
+            temp = next;
+        } while (temp != child);
+        nodes[z].child = -1;
+    }
+
+    // Видаляємо z з кореневого списку
+    nodes[nodes[z].left].right = nodes[z].right;
+    nodes[nodes[z].right].left = nodes[z].left;
+
+    if (z == nodes[z].right) {
+        min = -1;
+    } else {
+        min = nodes[z].right;
+        consolidate();
+    }
+
+    n--;
+    nodes[z].in_heap = false;
+    return {z, nodes[z].key};
+}
+
+void IndexedFibonacciHeap::clear() {
+    if (min == -1) return;
+
+    // Обхід усіх дерев, буфер roots використовується як стек
+    roots.clear();
+    roots.push_back(min);
+    while (!roots.empty()) {
+        int first = roots.back();
+        roots.pop_back();
+        int x = first;
+        do {
+            nodes[x].in_heap = false;
+            if (nodes[x].child != -1) {
+                roots.push_back(nodes[x].child);
+            }
+            x = nodes[x].right;
+        } while (x != first);
+    }
+    min = -1;
+    n = 0;
+}
@@ -0,0 +1,154 @@
+#include "../include/lazy_distance_matrix.h"
+#include "../include/constants.h"
+#include <stdexcept>
+#include <string>
+
+namespace {
+    void checkSource(int src, int V) {
+        if (src < 0 || src >= V) {
+            throw std::invalid_argument("Source vertex " + std::to_string(src) + " is out of range");
+        }
+    }
+}
+
+LazyDistanceMatrix::LazyDistanceMatrix(int V, std::shared_ptr<const ReweightedGraph> graph,
+                                       const DijkstraOptions& options, size_t capacity,
+                                       std::shared_ptr<ThreadPool> pool)
+        : state(std::make_shared<State>()), pool(std::move(pool)) {
+    state->V = V;
+    state->graph = std::move(graph);
+    state->options = options;
+    state->capacity = capacity;
+    if (this->pool) {
+        state->workspaces = std::make_unique<WorkerWorkspaces>(this->pool->getThreadCount());
+    }
+}
+
+LazyDistanceMatrix::RowPtr LazyDistanceMatrix::State::compute(int src, DijkstraWorkspace& workspace) const {
+    auto row = std::make_shared<std::vector<double>>(V, INF);
+    if (!graph) {
+        return row;
+    }
+
+    reweightedDijkstra(*graph, src, workspace, options);
+    const std::vector<double>& reached = workspace.getDist();
+    for (int v : workspace.getTouched()) {
+        (*row)[v] = reached[v] - graph->h[src] + graph->h[v];
+    }
+    return row;
+}
+
+void LazyDistanceMatrix::State::store(int src, const RowPtr& row) {
+    if (capacity == 0) return;
+    lru.push_front(src);
+    rows[src] = {row, lru.begin()};
+    while (rows.size() > capacity) {
+        rows.erase(lru.back());
+        lru.pop_back();
+    }
+}
+
+void LazyDistanceMatrix::fill(const std::shared_ptr<State>& state, int src, std::promise<RowPtr>& promise,
+                              DijkstraWorkspace& workspace) {
+    RowPtr row;
+    try {
+        row = state->compute(src, workspace);
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->in_flight.erase(src);
+        promise.set_exception(std::current_exception());
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->store(src, row);
+        state->in_flight.erase(src);
+    }
+    promise.set_value(row);
+}
+
+size_t LazyDistanceMatrix::getCachedRowCount() const {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    return state->rows.size();
+}
+
+bool LazyDistanceMatrix::isCached(int src) const {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    return state->rows.count(src) > 0;
+}
+
+LazyDistanceMatrix::RowPtr LazyDistanceMatrix::row(int src) {
+    checkSource(src, state->V);
+
+    std::promise<RowPtr> promise;
+    std::shared_future<RowPtr> result;
+    bool owner = false;
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        auto cached = state->rows.find(src);
+        if (cached != state->rows.end()) {
+            state->lru.splice(state->lru.begin(), state->lru, cached->second.second);
+            return cached->second.first;
+        }
+
+        // Рядок уже рахує інший потік - чекаємо на нього замість повторного запуску
+        auto running = state->in_flight.find(src);
+        if (running != state->in_flight.end()) {
+            result = running->second;
+        } else {
+            result = promise.get_future().share();
+            state->in_flight.emplace(src, result);
+            owner = true;
+        }
+    }
+
+    if (owner) {
+        DijkstraWorkspace workspace;
+        fill(state, src, promise, workspace);
+    } else if (pool && pool->currentWorker() < pool->getThreadCount()) {
+        // Завдання пулу не чекає на prefetch: воно може стояти в черзі за цим же завданням,
+        // тому рядок рахується тут же без запису в кеш, який заповнить prefetch
+        DijkstraWorkspace own;
+        return state->compute(src, state->workspaces->get(pool->currentWorker(), own));
+    }
+    return result.get();
+}
+
+void LazyDistanceMatrix::prefetch(const std::vector<int>& sources) {
+    for (int src : sources) {
+        checkSource(src, state->V);
+    }
+
+    DijkstraWorkspace caller_workspace;  // для рядків, які рахуються без пулу
+    for (int src : sources) {
+        auto promise = std::make_shared<std::promise<RowPtr>>();
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            if (state->rows.count(src) || state->in_flight.count(src)) continue;
+            state->in_flight.emplace(src, promise->get_future().share());
+        }
+
+        if (pool) {
+            // Завдання тримає стан живим, навіть якщо всі копії матриці вже знищено,
+            // а пул живий, поки виконується його завдання
+            std::shared_ptr<State> shared = state;
+            const ThreadPool* workers = pool.get();
+            try {
+                pool->enqueue([shared, src, promise, workers]() {
+                    DijkstraWorkspace own;
+                    fill(shared, src, *promise, shared->workspaces->get(workers->currentWorker(), own));
+                });
+            } catch (...) {
+                // Завдання не потрапило в пул: інакше всі наступні row(src) чекали б на нього вічно
+                {
+                    std::lock_guard<std::mutex> lock(state->mutex);
+                    state->in_flight.erase(src);
+                }
+                promise->set_exception(std::current_exception());
+                throw;
+            }
+        } else {
+            fill(state, src, *promise, caller_workspace);
+        }
+    }
+}
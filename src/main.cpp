@@ -5,6 +5,7 @@
 #include <stdexcept>
 #include <thread>
 #include "../include/graph.h"
+#include "../include/auto_strategy.h"
 #include "../include/benchmark.h"
 
 enum class ModeType {
@@ -28,12 +29,15 @@ public:
         Graph g(V);
 
         char strategy_choice;
-        std::cout << "Choose execution strategy: 's' for sequential, 'p' for parallel: ";
+        std::cout << "Choose execution strategy: 's' for sequential, 'p' for parallel, 'a' for automatic: ";
         std::cin >> strategy_choice;
 
         if (strategy_choice == 'p') {
             g.setStrategy(std::make_unique<ParallelDijkstraStrategy>());
             std::cout << "Using parallel strategy" << std::endl;
+        } else if (strategy_choice == 'a') {
+            g.setStrategy(std::make_unique<AutoStrategy>());
+            std::cout << "Using automatic strategy" << std::endl;
         } else {
             g.setStrategy(std::make_unique<SequentialStrategy>());
             std::cout << "Using sequential strategy" << std::endl;
@@ -60,6 +64,10 @@ public:
         std::cout << "Running benchmarks..." << std::endl;
         Benchmark benchmark;
         benchmark.runComprehensiveBenchmark();
+        std::cout << std::endl;
+        benchmark.benchmarkHeapTypes();
+        std::cout << std::endl;
+        benchmark.benchmarkAutoStrategy();
     }
 };
 
@@ -0,0 +1,171 @@
+#include "../include/priority_queues.h"
+#include <algorithm>
+#include <functional>
+
+std::string heapTypeName(HeapType type) {
+    switch (type) {
+        case HeapType::Fibonacci:
+            return "Fibonacci";
+        case HeapType::IndexedFibonacci:
+            return "IndexedFibonacci";
+        case HeapType::QuaternaryHeap:
+            return "4-ary";
+        case HeapType::Pairing:
+            return "Pairing";
+        case HeapType::LazyBinary:
+            return "LazyBinary";
+    }
+    return "Unknown";
+}
+
+// PairingHeap implementation
+PairingHeap::PairingHeap(int capacity) : nodes(capacity), root(-1) {
+    for (Node& node : nodes) {
+        node.in_heap = false;
+    }
+    pairs.reserve(capacity);
+}
+
+int PairingHeap::meld(int a, int b) {
+    if (a == -1) return b;
+    if (b == -1) return a;
+    if (nodes[b].key < nodes[a].key) std::swap(a, b);
+
+    // b стає першою дитиною a
+    nodes[b].prev = a;
+    nodes[b].next = nodes[a].child;
+    if (nodes[a].child != -1) {
+        nodes[nodes[a].child].prev = b;
+    }
+    nodes[a].child = b;
+    nodes[a].next = -1;
+    nodes[a].prev = -1;
+    return a;
+}
+
+void PairingHeap::detach(int x) {
+    int prev = nodes[x].prev;
+    if (nodes[prev].child == x) {
+        nodes[prev].child = nodes[x].next;
+    } else {
+        nodes[prev].next = nodes[x].next;
+    }
+    if (nodes[x].next != -1) {
+        nodes[nodes[x].next].prev = prev;
+    }
+    nodes[x].next = -1;
+    nodes[x].prev = -1;
+}
+
+void PairingHeap::insert(int vertex, double key) {
+    Node& node = nodes[vertex];
+    node.key = key;
+    node.child = -1;
+    node.next = -1;
+    node.prev = -1;
+    node.in_heap = true;
+    root = meld(root, vertex);
+}
+
+void PairingHeap::decreaseKey(int vertex, double newKey) {
+    if (newKey > nodes[vertex].key) return;
+    nodes[vertex].key = newKey;
+    if (vertex == root) return;
+
+    detach(vertex);
+    root = meld(root, vertex);
+}
+
+std::pair<int, double> PairingHeap::extractMin() {
+    if (root == -1) {
+        return {-1, INF};
+    }
+    int top = root;
+    nodes[top].in_heap = false;
+
+    // Перший прохід: зливаємо дітей попарно зліва направо
+    pairs.clear();
+    int child = nodes[top].child;
+    while (child != -1) {
+        int first = child;
+        int second = nodes[first].next;
+        child = second == -1 ? -1 : nodes[second].next;
+
+        nodes[first].next = nodes[first].prev = -1;
+        if (second != -1) {
+            nodes[second].next = nodes[second].prev = -1;
+        }
+        pairs.push_back(meld(first, second));
+    }
+
+    // Другий прохід: справа наліво
+    int result = -1;
+    for (auto it = pairs.rbegin(); it != pairs.rend(); ++it) {
+        result = meld(result, *it);
+    }
+    root = result;
+    nodes[top].child = -1;
+    return {top, nodes[top].key};
+}
+
+void PairingHeap::clear() {
+    if (root == -1) return;
+
+    // Обхід дерева, буфер pairs використовується як стек
+    pairs.clear();
+    pairs.push_back(root);
+    while (!pairs.empty()) {
+        int x = pairs.back();
+        pairs.pop_back();
+        nodes[x].in_heap = false;
+        for (int c = nodes[x].child; c != -1; c = nodes[c].next) {
+            pairs.push_back(c);
+        }
+    }
+    root = -1;
+}
+
+// LazyBinaryHeap implementation
+LazyBinaryHeap::LazyBinaryHeap(int capacity) : keys(capacity, INF), in_heap(capacity, false), n(0) {
+    entries.reserve(capacity);
+}
+
+void LazyBinaryHeap::insert(int vertex, double key) {
+    keys[vertex] = key;
+    in_heap[vertex] = true;
+    n++;
+    entries.emplace_back(key, vertex);
+    std::push_heap(entries.begin(), entries.end(), std::greater<>());
+}
+
+void LazyBinaryHeap::decreaseKey(int vertex, double newKey) {
+    if (newKey >= keys[vertex]) return;
+    keys[vertex] = newKey;
+    entries.emplace_back(newKey, vertex);
+    std::push_heap(entries.begin(), entries.end(), std::greater<>());
+}
+
+std::pair<int, double> LazyBinaryHeap::extractMin() {
+    while (!entries.empty()) {
+        std::pop_heap(entries.begin(), entries.end(), std::greater<>());
+        auto [key, vertex] = entries.back();
+        entries.pop_back();
+
+        // Пропускаємо застарілі записи
+        if (!in_heap[vertex] || key != keys[vertex]) continue;
+
+        in_heap[vertex] = false;
+        n--;
+        return {vertex, key};
+    }
+    return {-1, INF};
+}
+
+void LazyBinaryHeap::clear() {
+    for (const auto& entry : entries) {
+        in_heap[entry.second] = false;
+        keys[entry.second] = INF;
+    }
+    entries.clear();
+    n = 0;
+}
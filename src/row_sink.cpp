@@ -0,0 +1,144 @@
+#include "../include/row_sink.h"
+#include "../include/constants.h"
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+// CallbackRowSink implementation
+void CallbackRowSink::begin(int /*rows*/, int cols) {
+    this->cols = cols;
+}
+
+void CallbackRowSink::writeRow(int row, const double* values) {
+    std::lock_guard<std::mutex> lock(mutex);
+    callback(row, values, cols);
+}
+
+// BinaryFileRowSink implementation
+BinaryFileRowSink::BinaryFileRowSink(const std::string& path, DistancePrecision precision, size_t bufferBytes)
+        : path(path), precision(precision), buffer_size(bufferBytes) {}
+
+size_t BinaryFileRowSink::rowBytes() const {
+    return static_cast<size_t>(cols) * (precision == DistancePrecision::Float ? sizeof(float) : sizeof(double));
+}
+
+void BinaryFileRowSink::begin(int rows, int cols) {
+    std::lock_guard<std::mutex> lock(mutex);
+    this->cols = cols;
+    out.open(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Cannot open " + path + " for writing");
+    }
+
+    DistanceFileHeader header = makeDistanceFileHeader(rows, cols, precision);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    // Буфер вміщує хоча б один рядок
+    buffer.resize(std::max(buffer_size, rowBytes()));
+    buffered_rows = 0;
+}
+
+void BinaryFileRowSink::flush() {
+    if (buffered_rows == 0) return;
+    out.seekp(static_cast<std::streamoff>(sizeof(DistanceFileHeader) + first_row * rowBytes()));
+    out.write(buffer.data(), static_cast<std::streamsize>(buffered_rows * rowBytes()));
+    if (!out) {
+        throw std::runtime_error("Failed to write " + path);
+    }
+    buffered_rows = 0;
+}
+
+void BinaryFileRowSink::writeRow(int row, const double* values) {
+    std::lock_guard<std::mutex> lock(mutex);
+    // Рядок не продовжує буферизовану ділянку або для нього немає місця
+    if (buffered_rows > 0 && (row != first_row + buffered_rows || (buffered_rows + 1) * rowBytes() > buffer.size())) {
+        flush();
+    }
+    if (buffered_rows == 0) {
+        first_row = row;
+    }
+
+    char* target = buffer.data() + buffered_rows * rowBytes();
+    if (precision == DistancePrecision::Float) {
+        float* converted = reinterpret_cast<float*>(target);
+        for (int j = 0; j < cols; j++) converted[j] = static_cast<float>(values[j]);
+    } else {
+        std::memcpy(target, values, rowBytes());
+    }
+    buffered_rows++;
+}
+
+void BinaryFileRowSink::finish() {
+    std::lock_guard<std::mutex> lock(mutex);
+    flush();
+    out.close();
+    if (!out) {
+        throw std::runtime_error("Failed to write " + path);
+    }
+    buffer.clear();
+    buffer.shrink_to_fit();
+}
+
+// TsvRowSink implementation
+TsvRowSink::TsvRowSink(const std::string& path, bool roundTrip) : file(path), out(&file), round_trip(roundTrip) {
+    if (!file) {
+        throw std::runtime_error("Cannot open " + path + " for writing");
+    }
+}
+
+TsvRowSink::TsvRowSink(std::ostream& stream, bool roundTrip) : out(&stream), round_trip(roundTrip) {}
+
+void TsvRowSink::begin(int /*rows*/, int cols) {
+    std::lock_guard<std::mutex> lock(mutex);
+    this->cols = cols;
+    next_row = 0;
+    pending.clear();
+}
+
+void TsvRowSink::writeRow(int row, const double* values) {
+    // Форматуємо поза блокуванням, щоб потоки не чекали один на одного
+    std::string line;
+    line.reserve(static_cast<size_t>(cols) * 8);
+    char number[32];
+    for (int j = 0; j < cols; j++) {
+        if (values[j] == INF) {
+            line += "INF";
+        } else if (round_trip) {
+            auto result = std::to_chars(number, number + sizeof(number), values[j]);
+            line.append(number, result.ptr);
+        } else {
+            // Те саме, що виводить std::ostream за замовчуванням
+            int length = std::snprintf(number, sizeof(number), "%g", values[j]);
+            line.append(number, static_cast<size_t>(length));
+        }
+        line += '\t';
+    }
+    line += '\n';
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (row != next_row) {
+        pending.emplace(row, std::move(line));
+        return;
+    }
+    out->write(line.data(), static_cast<std::streamsize>(line.size()));
+    next_row++;
+    // Дописуємо рядки, які вже чекали на цей
+    for (auto it = pending.begin(); it != pending.end() && it->first == next_row; it = pending.erase(it)) {
+        out->write(it->second.data(), static_cast<std::streamsize>(it->second.size()));
+        next_row++;
+    }
+}
+
+void TsvRowSink::finish() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto& entry : pending) {
+        out->write(entry.second.data(), static_cast<std::streamsize>(entry.second.size()));
+    }
+    pending.clear();
+    out->flush();
+    if (!*out) {
+        throw std::runtime_error("Failed to write the rows");
+    }
+}
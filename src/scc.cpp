@@ -0,0 +1,83 @@
+#include "../include/scc.h"
+#include <algorithm>
+
+Condensation condense(const CSRGraph& g) {
+    int V = g.getV();
+    const size_t* offsets = g.getOffsets();
+    const int* targets = g.getTargets();
+
+    Condensation result;
+    result.component.assign(V, -1);
+
+    std::vector<int> index(V, -1), low(V, 0);
+    std::vector<char> on_stack(V, 0);
+    std::vector<int> stack;
+    // Явний стек викликів замість рекурсії: вершина і наступне ребро, яке треба переглянути
+    std::vector<std::pair<int, size_t>> frames;
+    int counter = 0;
+    int emitted = 0;
+
+    for (int s = 0; s < V; s++) {
+        if (index[s] != -1) continue;
+        index[s] = low[s] = counter++;
+        stack.push_back(s);
+        on_stack[s] = 1;
+        frames.emplace_back(s, offsets[s]);
+
+        while (!frames.empty()) {
+            int v = frames.back().first;
+            size_t i = frames.back().second;
+
+            if (i < offsets[v + 1]) {
+                frames.back().second++;
+                int w = targets[i];
+                if (index[w] == -1) {
+                    index[w] = low[w] = counter++;
+                    stack.push_back(w);
+                    on_stack[w] = 1;
+                    frames.emplace_back(w, offsets[w]);
+                } else if (on_stack[w]) {
+                    low[v] = std::min(low[v], index[w]);
+                }
+                continue;
+            }
+
+            // Усі ребра v переглянуто, повертаємось до батька
+            frames.pop_back();
+            if (!frames.empty()) {
+                int parent = frames.back().first;
+                low[parent] = std::min(low[parent], low[v]);
+            }
+            if (low[v] == index[v]) {
+                int x;
+                do {
+                    x = stack.back();
+                    stack.pop_back();
+                    on_stack[x] = 0;
+                    result.component[x] = emitted;
+                } while (x != v);
+                emitted++;
+            }
+        }
+    }
+
+    // Тар'ян видає компоненти у зворотному топологічному порядку
+    result.count = emitted;
+    for (int v = 0; v < V; v++) {
+        result.component[v] = emitted - 1 - result.component[v];
+    }
+
+    result.offsets.assign(result.count + 1, 0);
+    for (int v = 0; v < V; v++) {
+        result.offsets[result.component[v] + 1]++;
+    }
+    for (int c = 0; c < result.count; c++) {
+        result.offsets[c + 1] += result.offsets[c];
+    }
+    result.members.resize(V);
+    std::vector<size_t> position(result.offsets.begin(), result.offsets.end() - 1);
+    for (int v = 0; v < V; v++) {
+        result.members[position[result.component[v]]++] = v;
+    }
+    return result;
+}
@@ -1,29 +1,147 @@
 #include "../include/thread_pool.h"
+#include <algorithm>
+#include <iterator>
 
-ThreadPool::ThreadPool(size_t threads) : stop(false) {
+namespace {
+    // Пул і номер воркера, яким належить поточний потік
+    thread_local const ThreadPool* current_pool = nullptr;
+    thread_local size_t current_worker = 0;
+}
+
+ThreadPool::ThreadPool(size_t threads) : pending(0), sleeping(0), next_queue(0), stop(false) {
+    // Хоча б одна черга, щоб parallelFor працював і без воркерів
+    for(size_t i = 0; i < std::max<size_t>(threads, 1); ++i) {
+        queues.push_back(std::make_unique<WorkerQueue>());
+    }
     for(size_t i = 0; i < threads; ++i) {
-        workers.emplace_back([this] {
-        for(;;) {
-            std::function<void()> task;
-            {
-                std::unique_lock<std::mutex> lock(this->queue_mutex);
-                this->condition.wait(lock, [this]{ return this->stop || !this->tasks.empty(); });
-                if(this->stop && this->tasks.empty())
-                    return;
-                task = std::move(this->tasks.front());
-                this->tasks.pop();
+        workers.emplace_back([this, i] { workerLoop(i); });
+    }
+}
+
+size_t ThreadPool::currentIndex() const {
+    return current_pool == this ? current_worker : queues.size();
+}
+
+void ThreadPool::push(const Task& task) {
+    size_t index = currentIndex();
+    if (index == queues.size()) {
+        index = next_queue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+    }
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->tasks.push_back(task);
+    }
+    pending.fetch_add(1);
+
+    // Будимо потік лише якщо хтось справді спить
+    if (sleeping.load() > 0) {
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+        condition.notify_one();
+    }
+}
+
+bool ThreadPool::runPendingTask() {
+    size_t count = queues.size();
+    size_t self = currentIndex();
+    Task task{};
+    bool found = false;
+
+    // Спочатку власна черга з кінця
+    if (self < count) {
+        WorkerQueue& own = *queues[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = own.tasks.back();
+            own.tasks.pop_back();
+            found = true;
+        }
+    }
+
+    // Потім крадемо з початку чужих черг
+    size_t start = self < count ? self + 1 : next_queue.load(std::memory_order_relaxed);
+    for (size_t k = 0; k < count && !found; k++) {
+        WorkerQueue& victim = *queues[(start + k) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = victim.tasks.front();
+            victim.tasks.pop_front();
+            found = true;
+        }
+    }
+
+    if (!found) {
+        return false;
+    }
+    pending.fetch_sub(1);
+    task.run(task.data, task.begin, task.end);
+    return true;
+}
+
+bool ThreadPool::runTaskOf(const void* data) {
+    size_t count = queues.size();
+    size_t self = currentIndex();
+    size_t start = self < count ? self : next_queue.load(std::memory_order_relaxed);
+    Task task{};
+    bool found = false;
+
+    // Власна черга переглядається з кінця, чужі - з початку, як і при звичайному крадінні
+    for (size_t k = 0; k < count && !found; k++) {
+        size_t index = (start + k) % count;
+        WorkerQueue& queue = *queues[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (index == self) {
+            for (auto it = queue.tasks.rbegin(); it != queue.tasks.rend(); ++it) {
+                if (it->data == data) {
+                    task = *it;
+                    queue.tasks.erase(std::next(it).base());
+                    found = true;
+                    break;
+                }
             }
-            task();
+        } else {
+            for (auto it = queue.tasks.begin(); it != queue.tasks.end(); ++it) {
+                if (it->data == data) {
+                    task = *it;
+                    queue.tasks.erase(it);
+                    found = true;
+                    break;
+                }
             }
-        });
+        }
+    }
+
+    if (!found) {
+        return false;
+    }
+    pending.fetch_sub(1);
+    task.run(task.data, task.begin, task.end);
+    return true;
+}
+
+void ThreadPool::workerLoop(size_t index) {
+    current_pool = this;
+    current_worker = index;
+    for(;;) {
+        if (runPendingTask())
+            continue;
+        if (stop)
+            return;
+
+        sleeping.fetch_add(1);
+        {
+            std::unique_lock<std::mutex> lock(sleep_mutex);
+            condition.wait(lock, [this]{ return stop || pending.load() > 0; });
+        }
+        sleeping.fetch_sub(1);
     }
 }
+
 ThreadPool::~ThreadPool() {
     {
-        std::unique_lock<std::mutex> lock(queue_mutex);
+        std::unique_lock<std::mutex> lock(sleep_mutex);
         stop = true;
     }
     condition.notify_all();
     for(std::thread &worker: workers)
         worker.join();
-}
\ No newline at end of file
+}
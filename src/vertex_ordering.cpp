@@ -0,0 +1,124 @@
+#include "../include/vertex_ordering.h"
+#include <algorithm>
+#include <numeric>
+
+namespace {
+    ///@brief neighbors of every vertex over the edges in both directions
+    struct UndirectedAdjacency {
+        std::vector<size_t> offsets;
+        std::vector<int> neighbors;
+
+        size_t degree(int v) const { return offsets[v + 1] - offsets[v]; }
+    };
+
+    UndirectedAdjacency undirected(const CSRGraph& g) {
+        int V = g.getV();
+        const size_t* offsets = g.getOffsets();
+        const int* targets = g.getTargets();
+
+        UndirectedAdjacency result;
+        result.offsets.assign(V + 1, 0);
+        for (int u = 0; u < V; u++) {
+            for (size_t i = offsets[u]; i < offsets[u + 1]; i++) {
+                result.offsets[u + 1]++;
+                result.offsets[targets[i] + 1]++;
+            }
+        }
+        for (int v = 0; v < V; v++) {
+            result.offsets[v + 1] += result.offsets[v];
+        }
+        result.neighbors.resize(result.offsets[V]);
+        std::vector<size_t> position(result.offsets.begin(), result.offsets.end() - 1);
+        for (int u = 0; u < V; u++) {
+            for (size_t i = offsets[u]; i < offsets[u + 1]; i++) {
+                result.neighbors[position[u]++] = targets[i];
+                result.neighbors[position[targets[i]]++] = u;
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief breadth-first order of all components
+     * @param byDegree starting every component from its vertex of the smallest degree and visiting neighbors
+     * by increasing degree, as Cuthill-McKee does
+     */
+    std::vector<int> breadthFirstOrder(const CSRGraph& g, bool byDegree) {
+        int V = g.getV();
+        UndirectedAdjacency adj = undirected(g);
+
+        // Кандидати на початок компоненти
+        std::vector<int> starts(V);
+        std::iota(starts.begin(), starts.end(), 0);
+        if (byDegree) {
+            std::stable_sort(starts.begin(), starts.end(),
+                             [&adj](int a, int b) { return adj.degree(a) < adj.degree(b); });
+        }
+
+        std::vector<int> order;
+        order.reserve(V);
+        std::vector<char> visited(V, 0);
+        std::vector<int> next;
+
+        for (int s : starts) {
+            if (visited[s]) continue;
+            visited[s] = 1;
+            size_t head = order.size();
+            order.push_back(s);
+
+            // Черга - це сам хвіст order
+            while (head < order.size()) {
+                int u = order[head++];
+                next.clear();
+                for (size_t i = adj.offsets[u]; i < adj.offsets[u + 1]; i++) {
+                    int v = adj.neighbors[i];
+                    if (!visited[v]) {
+                        visited[v] = 1;
+                        next.push_back(v);
+                    }
+                }
+                if (byDegree) {
+                    std::stable_sort(next.begin(), next.end(),
+                                     [&adj](int a, int b) { return adj.degree(a) < adj.degree(b); });
+                }
+                order.insert(order.end(), next.begin(), next.end());
+            }
+        }
+        return order;
+    }
+}
+
+const char* vertexOrderingName(VertexOrdering ordering) {
+    switch (ordering) {
+        case VertexOrdering::None: return "None";
+        case VertexOrdering::BFS: return "BFS";
+        case VertexOrdering::ReverseCuthillMcKee: return "ReverseCuthillMcKee";
+        case VertexOrdering::DegreeSorted: return "DegreeSorted";
+    }
+    return "Unknown";
+}
+
+std::vector<int> computeVertexOrder(const CSRGraph& g, VertexOrdering ordering) {
+    int V = g.getV();
+    std::vector<int> order(V);
+    std::iota(order.begin(), order.end(), 0);
+
+    switch (ordering) {
+        case VertexOrdering::None:
+            break;
+        case VertexOrdering::BFS:
+            order = breadthFirstOrder(g, false);
+            break;
+        case VertexOrdering::ReverseCuthillMcKee:
+            order = breadthFirstOrder(g, true);
+            std::reverse(order.begin(), order.end());
+            break;
+        case VertexOrdering::DegreeSorted: {
+            UndirectedAdjacency adj = undirected(g);
+            std::stable_sort(order.begin(), order.end(),
+                             [&adj](int a, int b) { return adj.degree(a) > adj.degree(b); });
+            break;
+        }
+    }
+    return order;
+}
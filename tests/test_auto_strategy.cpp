@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include "../include/auto_strategy.h"
+#include "../include/row_sink.h"
+#include "../include/constants.h"
+#include "test_helpers.h"
+
+TEST(AutoStrategyTest, DenseGraphUsesFloydWarshall) {
+    Graph graph = makeRandomGraph(200, 1, 200 * 150, 0.0);
+    AutoDecision decision = AutoStrategy::choose(graph, 4);
+    EXPECT_EQ(decision.choice, AutoChoice::BlockedFloydWarshall);
+    EXPECT_FALSE(decision.reason.empty());
+}
+
+TEST(AutoStrategyTest, SparseGraphDependsOnThreads) {
+    Graph graph = makeRandomGraph(3000, 2, 3000 * 3, 0.0);
+    EXPECT_EQ(AutoStrategy::choose(graph, 4).choice, AutoChoice::ParallelDijkstra);
+    EXPECT_EQ(AutoStrategy::choose(graph, 1).choice, AutoChoice::Sequential);
+}
+
+TEST(AutoStrategyTest, SmallSparseGraphStaysSequential) {
+    Graph graph(200);
+    for (int v = 0; v + 1 < 200; v++) {
+        graph.addEdge(v, v + 1, 1.0);
+    }
+    EXPECT_EQ(AutoStrategy::choose(graph, 8).choice, AutoChoice::Sequential);
+}
+
+TEST(AutoStrategyTest, ChoiceMatchesFasterEngineOnBothSidesOfCrossover) {
+#if !defined(NDEBUG) || defined(__SANITIZE_THREAD__) || defined(__SANITIZE_ADDRESS__)
+    GTEST_SKIP() << "the cost model is fitted to optimized builds without instrumentation";
+#endif
+    auto bestTime = [](Graph& graph, std::unique_ptr<ParallelizationStrategy> strategy) {
+        graph.setStrategy(std::move(strategy));
+        double best = 1e30;
+        for (int attempt = 0; attempt < 3; attempt++) {
+            auto start = std::chrono::steady_clock::now();
+            graph.johnson();
+            best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+        }
+        return best;
+    };
+
+    // При тому самому V розріджений граф на боці Дейкстри, щільний - на боці Флойда-Воршелла
+    for (size_t E : {400, 400 * 32}) {
+        Graph graph = makeRandomGraph(400, 5, E, 0.0);
+        AutoDecision decision = AutoStrategy::choose(graph, 1);
+        auto johnson = std::make_unique<SequentialStrategy>();
+        johnson->setHeapType(HeapType::QuaternaryHeap);
+        johnson->setLazyInsertion(true);
+        double johnson_s = bestTime(graph, std::move(johnson));
+        double floyd_s = bestTime(graph, std::make_unique<BlockedFloydWarshallStrategy>(1));
+
+        SCOPED_TRACE(decision.reason);
+        EXPECT_EQ(decision.choice, floyd_s < johnson_s ? AutoChoice::BlockedFloydWarshall : AutoChoice::Sequential);
+    }
+}
+
+TEST(AutoStrategyTest, ResultMatchesSequential) {
+    Graph graph = makeRandomGraph(60, 3, 60 * 4, 0.0);
+    graph.addEdge(0, 1, -2.0);
+    graph.setStrategy(std::make_unique<SequentialStrategy>());
+    DistanceMatrix expected = graph.johnson();
+
+    auto strategy = std::make_unique<AutoStrategy>(2);
+    strategy->setLogging(false);
+    AutoStrategy* autoStrategy = strategy.get();
+    graph.setStrategy(std::move(strategy));
+    DistanceMatrix result = graph.johnson();
+
+    EXPECT_FALSE(autoStrategy->getLastDecision().reason.empty());
+    expectSameMatrix(result, expected);
+}
+
+TEST(AutoStrategyTest, StreamingWithOneThreadStaysSequential) {
+    // Для щільного графу execute() обрав би Флойда-Воршелла, але рядки рахує лише Дейкстра
+    Graph graph = makeRandomGraph(200, 1, 200 * 150, 0.0);
+    auto strategy = std::make_unique<AutoStrategy>(1);
+    strategy->setLogging(false);
+    AutoStrategy* automatic = strategy.get();
+    graph.setStrategy(std::move(strategy));
+
+    int rows = 0;
+    CallbackRowSink sink([&](int, const double*, int) { rows++; });
+    graph.johnson(sink);
+    EXPECT_EQ(rows, 200);
+    EXPECT_EQ(automatic->getLastDecision().choice, AutoChoice::Sequential);
+}
@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include "../include/graph.h"
+#include "../include/bellman_ford.h"
+#include "../include/constants.h"
+#include "test_helpers.h"
+
+TEST(BellmanFordTest, ParallelMatchesQueueBased) {
+    ThreadPool pool(3);
+    int cycles = 0;
+    for (unsigned seed = 0; seed < 200; seed++) {
+        int V = 2 + seed % 40;
+        Graph graph = makeRandomIntegerGraph(V, static_cast<int>(seed % 3 + 1) * V, seed);
+        auto csr = graph.getCSR();
+
+        std::vector<double> expected(V, INF), actual(V, INF);
+        expected[0] = actual[0] = 0;
+        bool expected_ok = queueBellmanFord(*csr, expected);
+        bool actual_ok = parallelBellmanFord(*csr, actual, pool);
+
+        ASSERT_EQ(expected_ok, actual_ok) << "seed " << seed;
+        if (expected_ok) {
+            EXPECT_EQ(expected, actual) << "seed " << seed;
+        } else {
+            cycles++;
+        }
+    }
+    // Перевірка має покривати обидва випадки
+    EXPECT_GT(cycles, 0);
+    EXPECT_LT(cycles, 200);
+}
+
+TEST(BellmanFordTest, ParallelPotentials) {
+    Graph graph(4);
+    graph.addEdge(0, 1, -1);
+    graph.addEdge(1, 2, -3);
+    graph.addEdge(2, 3, 2);
+    graph.addEdge(3, 1, 1);
+    auto csr = graph.getCSR();
+
+    ThreadPool pool(2);
+    std::vector<double> h(4, 0);
+    ASSERT_TRUE(parallelBellmanFord(*csr, h, pool));
+    EXPECT_EQ(h, (std::vector<double>{0, -1, -4, -2}));
+}
+
+TEST(BellmanFordTest, ParallelNegativeSelfLoop) {
+    Graph graph(1);
+    graph.addEdge(0, 0, -1);
+    ThreadPool pool(2);
+    std::vector<double> h(1, 0);
+    EXPECT_FALSE(parallelBellmanFord(*graph.getCSR(), h, pool));
+}
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include "../include/distance_file.h"
+#include "../include/row_sink.h"
+#include "../include/graph.h"
+#include "../include/constants.h"
+#include "test_helpers.h"
+
+class DistanceFileTest : public TempFileTest {};
+
+TEST_F(DistanceFileTest, OutOfCoreMatchesJohnson) {
+    Graph graph = makeRandomGraph(150, 1);
+    DistanceMatrix expected = expectedMatrix(graph);
+
+    ParallelDijkstraStrategy strategy(3);
+    // Бюджет на 7 рядків: по 3 рядки на плитку, остання плитка неповна
+    strategy.executeToFile(graph, path, 7 * 150 * sizeof(double));
+
+    DistanceFile file(path);
+    ASSERT_EQ(file.getRows(), 150);
+    ASSERT_EQ(file.getCols(), 150);
+    EXPECT_EQ(file.getPrecision(), DistancePrecision::Double);
+    for (int i = 0; i < 150; i++) {
+        expectRow(file.readRow(i), expected, i);
+    }
+    expectSameDistance(file.at(149, 3), expected[149][3]);
+}
+
+TEST_F(DistanceFileTest, TilesInFloatPrecision) {
+    Graph graph = makeRandomGraph(80, 2);
+    DistanceMatrix expected = expectedMatrix(graph);
+
+    ParallelDijkstraStrategy strategy(2);
+    strategy.executeToFile(graph, path, 1 << 20, DistancePrecision::Float);
+
+    DistanceFile file(path);
+    EXPECT_EQ(file.getPrecision(), DistancePrecision::Float);
+    DistanceMatrix tile = file.readTile(10, 25);
+    EXPECT_EQ(tile.getPrecision(), DistancePrecision::Float);
+    ASSERT_EQ(tile.getRows(), 25);
+    for (int i = 0; i < 25; i++) {
+        expectRow(tile[i], expected, 10 + i, 1e-4);
+    }
+
+    DistanceMatrix wide(5, 80, DistancePrecision::Double);
+    file.readTile(75, wide);
+    expectSameDistance(wide[4][0], expected[79][0], 1e-4);
+    EXPECT_THROW(file.readTile(76, wide), std::out_of_range);
+    EXPECT_THROW(file.at(80, 0), std::out_of_range);
+}
+
+TEST_F(DistanceFileTest, ReadsBinaryRowSinkOutput) {
+    Graph graph = makeRandomGraph(60, 3);
+    graph.setStrategy(std::make_unique<ParallelDijkstraStrategy>(2));
+    DistanceMatrix expected = graph.johnson();
+
+    BinaryFileRowSink sink(path);
+    graph.johnson(sink);
+
+    DistanceFile file(path);
+    for (int i = 0; i < 60; i++) {
+        for (int j = 0; j < 60; j++) {
+            expectSameDistance(file.at(i, j), expected[i][j]);
+        }
+    }
+}
+
+TEST_F(DistanceFileTest, NegativeCycleAndInvalidFiles) {
+    Graph graph(4);
+    graph.addEdge(0, 1, 1.0);
+    graph.addEdge(1, 0, -3.0);
+    ParallelDijkstraStrategy strategy(2);
+    strategy.executeToFile(graph, path, 64);
+
+    DistanceFile file(path);
+    for (int i = 0; i < 4; i++) {
+        for (double value : file.readRow(i)) EXPECT_EQ(value, INF);
+    }
+
+    EXPECT_THROW(DistanceFile(path + ".missing"), std::runtime_error);
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << std::string(100, 'x');
+    }
+    EXPECT_THROW(DistanceFile file2(path), std::runtime_error);
+
+    // rows * cols * 8 = 2^64 + 32, тобто без перевірки на переповнення файл здавався б достатньо довгим
+    {
+        DistanceFileHeader header = makeDistanceFileHeader(1263665316, 1824726041, DistancePrecision::Double);
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out << std::string(100, 'x');
+    }
+    EXPECT_THROW(DistanceFile file3(path), std::runtime_error);
+}
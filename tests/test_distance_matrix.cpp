@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#include "../include/distance_matrix.h"
+#include "../include/graph.h"
+#include "../include/constants.h"
+
+TEST(DistanceMatrixTest, FilledWithInfinity) {
+    DistanceMatrix dist(3, 5);
+    EXPECT_EQ(dist.size(), 3u);
+    EXPECT_EQ(dist[0].size(), 5u);
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 5; j++) {
+            EXPECT_EQ(dist[i][j], INF);
+        }
+    }
+}
+
+TEST(DistanceMatrixTest, RowsAreAlignedToCacheLine) {
+    DistanceMatrix dist(4, 5);
+    EXPECT_EQ(dist.getStride(), 8u);
+    for (int i = 0; i < 4; i++) {
+        auto address = reinterpret_cast<std::uintptr_t>(dist.rowData<double>(i));
+        EXPECT_EQ(address % DistanceMatrix::CACHE_LINE, 0u);
+    }
+
+    DistanceMatrix unpadded(4, 5, DistancePrecision::Double, alignof(double));
+    EXPECT_EQ(unpadded.getStride(), 5u);
+}
+
+TEST(DistanceMatrixTest, InvalidAlignmentIsRejected) {
+    EXPECT_THROW(DistanceMatrix(2, 2, DistancePrecision::Double, 48), std::invalid_argument);
+    EXPECT_THROW(DistanceMatrix(2, 2, DistancePrecision::Float, 4), std::invalid_argument);
+    EXPECT_THROW(DistanceMatrix(2, 2, DistancePrecision::Double, 0), std::invalid_argument);
+}
+
+TEST(DistanceMatrixTest, FloatStorage) {
+    DistanceMatrix dist(2, 3, DistancePrecision::Float);
+    std::vector<double> row = {1.5, -2.25, INF};
+    dist.setRow(1, row.data());
+    dist.set(0, 0, 7.0);
+
+    EXPECT_EQ(dist.getStride(), 16u);
+    EXPECT_EQ(dist[1][0], 1.5);
+    EXPECT_EQ(dist[1][1], -2.25);
+    EXPECT_EQ(dist[1][2], INF);
+    EXPECT_EQ(dist.at(0, 0), 7.0);
+    EXPECT_EQ(dist.getByteSize(), 2 * 16 * sizeof(float));
+}
+
+TEST(DistanceMatrixTest, JohnsonWithFloatPrecision) {
+    Graph graph(3);
+    graph.setStrategy(std::make_unique<ParallelDijkstraStrategy>(2));
+    graph.setDistancePrecision(DistancePrecision::Float);
+    graph.addEdge(0, 1, 2.5);
+    graph.addEdge(1, 2, -1.0);
+
+    DistanceMatrix result = graph.johnson();
+    EXPECT_EQ(result.getPrecision(), DistancePrecision::Float);
+    EXPECT_EQ(result[0][2], 1.5);
+    EXPECT_EQ(result[2][0], INF);
+}
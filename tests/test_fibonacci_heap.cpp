@@ -1,5 +1,9 @@
 #include <gtest/gtest.h>
+#include <random>
+#include <vector>
 #include "../include/fibonacci_heap.h"
+#include "../include/indexed_fibonacci_heap.h"
+#include "../include/priority_queues.h"
 #include "../include/constants.h"
 
 class FibonacciHeapTest : public ::testing::Test {
@@ -81,4 +85,107 @@ TEST_F(FibonacciHeapTest, ExtractMinFromEmptyHeap) {
     auto result = heap->extractMin();
     EXPECT_EQ(result.first, -1);
     EXPECT_EQ(result.second, INF);
-}
\ No newline at end of file
+}
+
+class IndexedFibonacciHeapTest : public ::testing::Test {
+protected:
+    IndexedFibonacciHeap heap{100};
+};
+
+TEST_F(IndexedFibonacciHeapTest, EmptyHeap) {
+    EXPECT_TRUE(heap.isEmpty());
+    EXPECT_FALSE(heap.contains(0));
+    auto result = heap.extractMin();
+    EXPECT_EQ(result.first, -1);
+    EXPECT_EQ(result.second, INF);
+}
+
+TEST_F(IndexedFibonacciHeapTest, DecreaseKeyAndExtract) {
+    heap.insert(0, 10.0);
+    heap.insert(1, 20.0);
+    heap.insert(2, 30.0);
+    EXPECT_TRUE(heap.contains(2));
+
+    heap.decreaseKey(2, 5.0);
+    heap.decreaseKey(0, 50.0);  // збільшення ключа ігнорується
+
+    auto result = heap.extractMin();
+    EXPECT_EQ(result.first, 2);
+    EXPECT_EQ(result.second, 5.0);
+    EXPECT_FALSE(heap.contains(2));
+    EXPECT_EQ(heap.extractMin().first, 0);
+    EXPECT_EQ(heap.extractMin().first, 1);
+    EXPECT_TRUE(heap.isEmpty());
+}
+
+TEST_F(IndexedFibonacciHeapTest, MatchesSortedOrderWithReinsertion) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> key_dist(0.0, 1000.0);
+
+    // Два раунди, щоб перевірити повторне використання вузлів після extractMin
+    for (int round = 0; round < 2; round++) {
+        std::vector<double> keys(100);
+        for (int v = 0; v < 100; v++) {
+            keys[v] = key_dist(rng);
+            heap.insert(v, keys[v]);
+        }
+        auto first = heap.extractMin();
+        heap.insert(first.first, first.second);
+        for (int v = 0; v < 100; v += 3) {
+            keys[v] /= 2;
+            if (heap.contains(v)) heap.decreaseKey(v, keys[v]);
+        }
+
+        double previous = -1;
+        int extracted = 0;
+        while (!heap.isEmpty()) {
+            auto [v, key] = heap.extractMin();
+            EXPECT_GE(key, previous);
+            previous = key;
+            extracted++;
+        }
+        EXPECT_EQ(extracted, 100);
+    }
+}
+
+
+// Спільні тести для всіх черг з пріоритетом, які можна підставити в Дейкстру
+template<class Heap>
+class PriorityQueueTest : public ::testing::Test {};
+
+using PriorityQueueTypes = ::testing::Types<FibonacciHeap, IndexedFibonacciHeap, DaryHeap<4>, PairingHeap, LazyBinaryHeap>;
+TYPED_TEST_SUITE(PriorityQueueTest, PriorityQueueTypes);
+
+TYPED_TEST(PriorityQueueTest, ExtractsInKeyOrderAfterDecreases) {
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> key_dist(0.0, 1000.0);
+    TypeParam heap(200);
+
+    std::vector<double> keys(200);
+    for (int v = 0; v < 200; v++) {
+        keys[v] = key_dist(rng);
+        heap.insert(v, keys[v]);
+    }
+    for (int i = 0; i < 50; i++) {
+        heap.extractMin();
+    }
+    for (int v = 0; v < 200; v += 2) {
+        if (heap.contains(v)) {
+            keys[v] /= 4;
+            heap.decreaseKey(v, keys[v]);
+        }
+    }
+
+    double previous = -1;
+    int extracted = 0;
+    while (!heap.isEmpty()) {
+        auto [v, key] = heap.extractMin();
+        EXPECT_EQ(key, keys[v]);
+        EXPECT_GE(key, previous);
+        EXPECT_FALSE(heap.contains(v));
+        previous = key;
+        extracted++;
+    }
+    EXPECT_EQ(extracted, 150);
+    EXPECT_EQ(heap.extractMin().first, -1);
+}
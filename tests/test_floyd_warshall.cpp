@@ -0,0 +1,43 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include "../include/floyd_warshall.h"
+#include "../include/constants.h"
+#include "test_helpers.h"
+
+TEST(BlockedFloydWarshallTest, MatchesJohnsonWithPartialBlocks) {
+    Graph graph = makeRandomGraph(37, 1, 37 * 36 * 3 / 10, 5.0);
+    DistanceMatrix expected = expectedMatrix(graph);
+
+    auto strategy = std::make_unique<BlockedFloydWarshallStrategy>(3);
+    strategy->setBlockSize(8);
+    graph.setStrategy(std::move(strategy));
+    DistanceMatrix result = graph.johnson();
+
+    expectSameMatrix(result, expected);
+}
+
+TEST(BlockedFloydWarshallTest, FloatPrecision) {
+    Graph graph = makeRandomGraph(20, 2, 20 * 19 / 2, 5.0);
+    DistanceMatrix expected = expectedMatrix(graph);
+
+    graph.setStrategy(std::make_unique<BlockedFloydWarshallStrategy>(2));
+    graph.setDistancePrecision(DistancePrecision::Float);
+    DistanceMatrix result = graph.johnson();
+
+    expectSameMatrix(result, expected, 1e-3);
+}
+
+TEST(BlockedFloydWarshallTest, NegativeCycle) {
+    Graph graph(3);
+    graph.addEdge(0, 1, 1);
+    graph.addEdge(1, 2, -3);
+    graph.addEdge(2, 0, 1);
+    graph.setStrategy(std::make_unique<BlockedFloydWarshallStrategy>(2));
+
+    testing::internal::CaptureStdout();
+    DistanceMatrix result = graph.johnson();
+    std::string output = testing::internal::GetCapturedStdout();
+
+    EXPECT_FALSE(output.empty());
+    EXPECT_EQ(result[0][0], INF);
+}
@@ -1,6 +1,11 @@
 #include <gtest/gtest.h>
+#include <future>
+#include <thread>
+#include <random>
 #include "../include/graph.h"
 #include "../include/constants.h"
+#include "../include/thread_pool.h"
+#include "test_helpers.h"
 
 class GraphTest : public ::testing::Test {
 protected:
@@ -27,6 +32,31 @@ TEST_F(GraphTest, AddEdge) {
     EXPECT_EQ(adj[0].front().weight, 5.0);
 }
 
+TEST_F(GraphTest, FinalizeBuildsCSR) {
+    graph->addEdge(0, 1, 5.0);
+    graph->addEdge(0, 2, 3.0);
+    graph->addEdge(2, 3, -1.0);
+
+    auto csr = graph->getCSR();
+    EXPECT_EQ(csr->getV(), 4);
+    EXPECT_EQ(csr->getEdgeCount(), 3u);
+    EXPECT_EQ(csr->edgesBegin(0), 0u);
+    EXPECT_EQ(csr->edgesEnd(0), 2u);
+    EXPECT_EQ(csr->edgesBegin(1), csr->edgesEnd(1));
+    EXPECT_EQ(csr->getTargets()[2], 3);
+    EXPECT_EQ(csr->getWeights()[2], -1.0);
+}
+
+TEST_F(GraphTest, AddEdgeAfterFinalizeRebuildsCSR) {
+    graph->addEdge(0, 1, 5.0);
+    graph->finalize();
+    graph->addEdge(1, 2, 2.0);
+
+    auto csr = graph->getCSR();
+    EXPECT_EQ(csr->getEdgeCount(), 2u);
+    EXPECT_EQ(csr->getTargets()[csr->edgesBegin(1)], 2);
+}
+
 TEST_F(GraphTest, BellmanFordNoNegativeCycle) {
     graph->addEdge(0, 1, -1);
     graph->addEdge(1, 2, -3);
@@ -55,6 +85,53 @@ TEST_F(GraphTest, BellmanFordWithNegativeCycle) {
     EXPECT_FALSE(result);
 }
 
+TEST_F(GraphTest, BellmanFordIgnoresUnreachableNegativeCycle) {
+    graph->addEdge(0, 1, 2);
+    graph->addEdge(2, 3, -4);
+    graph->addEdge(3, 2, 1);
+
+    std::vector<double> dist;
+    EXPECT_TRUE(graph->bellmanFord(0, dist));
+    EXPECT_EQ(dist[1], 2);
+    EXPECT_EQ(dist[2], INF);
+    EXPECT_FALSE(graph->bellmanFord(2, dist));
+}
+
+TEST_F(GraphTest, BellmanFordNegativeSelfLoop) {
+    graph->addEdge(0, 1, 1);
+    graph->addEdge(1, 1, -1);
+
+    std::vector<double> dist;
+    EXPECT_FALSE(graph->bellmanFord(0, dist));
+}
+
+TEST_F(GraphTest, ReweightWithImplicitSource) {
+    graph->addEdge(0, 1, -1);
+    graph->addEdge(1, 2, -3);
+    graph->addEdge(2, 3, 2);
+    graph->addEdge(3, 1, 1);
+
+    ReweightedGraph reweighted;
+    ASSERT_TRUE(graph->reweight(reweighted));
+    EXPECT_EQ(reweighted.h[0], 0);
+    EXPECT_EQ(reweighted.h[1], -1);
+    EXPECT_EQ(reweighted.h[2], -4);
+    EXPECT_EQ(reweighted.h[3], -2);
+
+    ASSERT_EQ(reweighted.weights.size(), reweighted.csr->getEdgeCount());
+    for (double w : reweighted.weights) {
+        EXPECT_GE(w, 0);
+    }
+}
+
+TEST_F(GraphTest, ReweightDetectsNegativeCycle) {
+    graph->addEdge(1, 2, -3);
+    graph->addEdge(2, 1, 2);
+
+    ReweightedGraph reweighted;
+    EXPECT_FALSE(graph->reweight(reweighted));
+}
+
 TEST_F(GraphTest, DijkstraSimple) {
     graph->addEdge(0, 1, 2);
     graph->addEdge(0, 2, 4);
@@ -71,6 +148,95 @@ TEST_F(GraphTest, DijkstraSimple) {
     EXPECT_EQ(dist[3], 6);
 }
 
+TEST_F(GraphTest, DijkstraSameResultForAllHeapTypes) {
+    graph->addEdge(0, 1, 2);
+    graph->addEdge(0, 2, 4);
+    graph->addEdge(1, 2, 1);
+    graph->addEdge(1, 3, 7);
+    graph->addEdge(2, 3, 3);
+
+    for (bool lazy : {false, true}) {
+        for (HeapType heap : {HeapType::Fibonacci, HeapType::IndexedFibonacci, HeapType::QuaternaryHeap,
+                              HeapType::Pairing, HeapType::LazyBinary}) {
+            DijkstraOptions options;
+            options.heap = heap;
+            options.lazy_insertion = lazy;
+            std::vector<double> dist;
+            graph->dijkstra(1, dist, options);
+
+            EXPECT_EQ(dist[0], INF) << heapTypeName(heap) << " lazy=" << lazy;
+            EXPECT_EQ(dist[1], 0) << heapTypeName(heap) << " lazy=" << lazy;
+            EXPECT_EQ(dist[2], 1) << heapTypeName(heap) << " lazy=" << lazy;
+            EXPECT_EQ(dist[3], 4) << heapTypeName(heap) << " lazy=" << lazy;
+        }
+    }
+}
+
+TEST_F(GraphTest, WorkspaceReusedBetweenSources) {
+    graph->addEdge(0, 1, 2);
+    graph->addEdge(1, 2, 1);
+    graph->addEdge(3, 0, 5);
+
+    ReweightedGraph reweighted;
+    ASSERT_TRUE(graph->reweight(reweighted));
+
+    DijkstraWorkspace workspace;
+    for (bool lazy : {false, true}) {
+        for (HeapType heap : {HeapType::Fibonacci, HeapType::IndexedFibonacci, HeapType::QuaternaryHeap,
+                              HeapType::Pairing, HeapType::LazyBinary}) {
+            DijkstraOptions options;
+            options.heap = heap;
+            options.lazy_insertion = lazy;
+
+            // Після ранньої зупинки з вершини 2 той самий workspace дає повний результат з вершини 3
+            for (int src : {2, 3, 0}) {
+                std::vector<double> expected;
+                reweightedDijkstra(reweighted, src, expected, options);
+                reweightedDijkstra(reweighted, src, workspace, options);
+                EXPECT_EQ(workspace.getDist(), expected) << heapTypeName(heap) << " src=" << src;
+            }
+            EXPECT_EQ(workspace.getTouched().size(), 3u);
+        }
+    }
+}
+
+TEST(WorkerWorkspacesTest, EveryWorkerHasOwnSlot) {
+    ThreadPool pool(3);
+    WorkerWorkspaces workspaces(pool.getThreadCount());
+    DijkstraWorkspace outside;
+
+    // Потік поза пулом отримує власну пам'ять, кожен воркер - свій слот
+    EXPECT_EQ(&workspaces.get(pool.currentWorker(), outside), &outside);
+    EXPECT_NE(&workspaces.get(0, outside), &workspaces.get(1, outside));
+    EXPECT_NE(&workspaces.get(1, outside), &workspaces.get(2, outside));
+
+    std::vector<std::future<bool>> results;
+    for (int k = 0; k < 6; k++) {
+        results.push_back(pool.enqueue([&]() {
+            size_t worker = pool.currentWorker();
+            return worker < 3 && &workspaces.get(worker, outside) != &outside;
+        }));
+    }
+    for (auto& result : results) {
+        EXPECT_TRUE(result.get());
+    }
+}
+
+TEST_F(GraphTest, JohnsonLazyInsertionWithUnreachableVertices) {
+    auto strategy = std::make_unique<SequentialStrategy>();
+    strategy->setLazyInsertion(true);
+    graph->setStrategy(std::move(strategy));
+
+    graph->addEdge(0, 1, 4);
+    graph->addEdge(2, 3, -2);
+
+    auto result = graph->johnson();
+    EXPECT_EQ(result[0][1], 4);
+    EXPECT_EQ(result[0][2], INF);
+    EXPECT_EQ(result[2][3], -2);
+    EXPECT_EQ(result[3][2], INF);
+}
+
 TEST_F(GraphTest, JohnsonSequential) {
     graph->setStrategy(std::make_unique<SequentialStrategy>());
 
@@ -113,9 +279,186 @@ TEST_F(GraphTest, JohnsonParallel) {
     EXPECT_EQ(result[0][3], -4);
 }
 
+TEST_F(GraphTest, DistancesFromSingleSource) {
+    graph->setStrategy(std::make_unique<SequentialStrategy>());
+    graph->addEdge(0, 1, 3);
+    graph->addEdge(0, 3, -4);
+    graph->addEdge(3, 2, -5);
+    graph->addEdge(2, 1, 4);
+
+    std::vector<double> dist = graph->distancesFrom(0);
+    EXPECT_EQ(dist, (std::vector<double>{0, -5, -9, -4}));
+    EXPECT_EQ(graph->distancesFrom(1)[0], INF);
+
+    // Кеш потенціалів скидається після зміни ребер
+    graph->addEdge(1, 0, 10);
+    EXPECT_EQ(graph->distancesFrom(1)[0], 10);
+    EXPECT_THROW(graph->distancesFrom(4), std::invalid_argument);
+}
+
+TEST_F(GraphTest, DistancesFromSourceSet) {
+    graph->addEdge(0, 1, 3);
+    graph->addEdge(0, 2, 8);
+    graph->addEdge(0, 3, -4);
+    graph->addEdge(1, 3, 1);
+    graph->addEdge(2, 1, 4);
+    graph->addEdge(3, 1, 7);
+    graph->addEdge(3, 2, -5);
+    graph->setStrategy(std::make_unique<SequentialStrategy>());
+    DistanceMatrix full = graph->johnson();
+
+    std::vector<int> sources = {3, 0, 3};
+    std::unique_ptr<ParallelizationStrategy> strategies[] = {
+            std::make_unique<SequentialStrategy>(),
+            std::make_unique<ParallelDijkstraStrategy>(2)
+    };
+    for (auto& strategy : strategies) {
+        graph->setStrategy(std::move(strategy));
+        DistanceMatrix result = graph->distancesFrom(sources);
+        ASSERT_EQ(result.getRows(), 3);
+        ASSERT_EQ(result.getCols(), 4);
+        for (int i = 0; i < 3; i++) {
+            for (int v = 0; v < 4; v++) {
+                EXPECT_EQ(result[i][v], full[sources[i]][v]);
+            }
+        }
+    }
+
+    DistanceMatrix wrong(2, 4);
+    EXPECT_THROW(graph->distancesFrom(sources, wrong), std::invalid_argument);
+}
+
+TEST_F(GraphTest, DistancesFromWithNegativeCycle) {
+    graph->setStrategy(std::make_unique<ParallelDijkstraStrategy>(2));
+    graph->addEdge(1, 2, -3);
+    graph->addEdge(2, 1, 2);
+
+    testing::internal::CaptureStdout();
+    DistanceMatrix result = graph->distancesFrom(std::vector<int>{0});
+    std::string output = testing::internal::GetCapturedStdout();
+    EXPECT_FALSE(output.empty());
+    EXPECT_EQ(result[0][0], INF);
+}
+
+TEST_F(GraphTest, PotentialsCachedPerVersion) {
+    graph->setStrategy(std::make_unique<SequentialStrategy>());
+    graph->addEdge(0, 1, -2);
+    graph->addEdge(1, 2, 3);
+    uint64_t version = graph->getVersion();
+
+    auto first = graph->getReweighted();
+    graph->johnson();
+    graph->distancesFrom(0);
+    EXPECT_EQ(graph->getReweighted(), first);
+    EXPECT_EQ(graph->getVersion(), version);
+
+    EXPECT_TRUE(graph->setEdgeWeight(1, 2, -1));
+    EXPECT_GT(graph->getVersion(), version);
+    EXPECT_NE(graph->getReweighted(), first);
+    EXPECT_EQ(graph->johnson()[0][2], -3);
+
+    testing::internal::CaptureStdout();
+    EXPECT_FALSE(graph->setEdgeWeight(2, 0, 1));
+    testing::internal::GetCapturedStdout();
+}
+
+TEST_F(GraphTest, NegativeCycleCachedUntilWeightChange) {
+    graph->setStrategy(std::make_unique<SequentialStrategy>());
+    graph->addEdge(0, 1, 1);
+    graph->addEdge(1, 0, -2);
+    EXPECT_EQ(graph->getReweighted(), nullptr);
+    EXPECT_EQ(graph->getReweighted(), nullptr);
+
+    graph->setEdgeWeight(1, 0, 2);
+    ASSERT_NE(graph->getReweighted(), nullptr);
+    EXPECT_EQ(graph->distancesFrom(1)[0], 2);
+}
+
 TEST_F(GraphTest, InvalidEdge) {
     testing::internal::CaptureStdout();
     graph->addEdge(-1, 0, 1);
     std::string output = testing::internal::GetCapturedStdout();
     EXPECT_FALSE(output.empty());
-}
\ No newline at end of file
+}
+
+TEST(GraphSharedPoolTest, ConcurrentJohnsonOnSharedPool) {
+    auto pool = std::make_shared<ThreadPool>(3);
+
+    std::vector<Graph> graphs;
+    for (int k = 0; k < 4; k++) {
+        Graph g(30);
+        for (int v = 0; v + 1 < 30; v++) {
+            g.addEdge(v, v + 1, k + 1);
+        }
+        g.setStrategy(std::make_unique<ParallelDijkstraStrategy>(pool));
+        graphs.push_back(std::move(g));
+    }
+
+    // Кілька запитів на одному пулі одночасно, кожен ще й двічі поспіль
+    std::vector<DistanceMatrix> results(graphs.size());
+    std::vector<std::thread> callers;
+    for (size_t k = 0; k < graphs.size(); k++) {
+        callers.emplace_back([&, k]() {
+            graphs[k].johnson();
+            results[k] = graphs[k].johnson();
+        });
+    }
+    for (auto& caller : callers) {
+        caller.join();
+    }
+
+    for (size_t k = 0; k < graphs.size(); k++) {
+        EXPECT_EQ(results[k][0][29], 29.0 * (k + 1));
+        EXPECT_EQ(results[k][29][0], INF);
+    }
+    EXPECT_EQ(pool->getThreadCount(), 3u);
+}
+
+TEST(GraphIncrementalTest, MatchesFullRecomputation) {
+    std::mt19937 rng(4);
+    std::uniform_int_distribution<int> vertex(0, 24);
+    std::uniform_real_distribution<double> weight(0.0, 10.0);
+
+    for (DistancePrecision precision : {DistancePrecision::Double, DistancePrecision::Float}) {
+        Graph graph(25);
+        graph.setDistancePrecision(precision);
+        graph.setStrategy(std::make_unique<SequentialStrategy>());
+        for (int k = 0; k < 40; k++) {
+            graph.addEdge(vertex(rng), vertex(rng), weight(rng));
+        }
+        DistanceMatrix dist = graph.johnson();
+
+        for (int k = 0; k < 30; k++) {
+            // Від'ємні ребра лише вперед, зворотні настільки важкі, що циклів з від'ємною вагою немає
+            int u = vertex(rng), v = vertex(rng);
+            if (u == v) continue;
+            ASSERT_TRUE(graph.addEdge(u, v, u < v ? weight(rng) - 2.0 : weight(rng) + 50.0, dist));
+            expectSameMatrix(dist, graph.johnson(), 1e-3);
+        }
+    }
+}
+
+TEST(GraphIncrementalTest, WeightDecreaseAndNegativeCycle) {
+    Graph graph(3);
+    graph.setStrategy(std::make_unique<SequentialStrategy>());
+    graph.addEdge(0, 1, 5);
+    graph.addEdge(1, 2, 1);
+    graph.addEdge(2, 0, 1);
+    DistanceMatrix dist = graph.johnson();
+
+    ASSERT_TRUE(graph.decreaseEdgeWeight(0, 1, 2, dist));
+    EXPECT_EQ(dist[0][2], 3);
+    EXPECT_EQ(dist[2][1], 3);
+    EXPECT_THROW(graph.decreaseEdgeWeight(0, 1, 4, dist), std::invalid_argument);
+    // Помилки виклику не змінюють матрицю, на відміну від від'ємного циклу
+    EXPECT_THROW(graph.decreaseEdgeWeight(0, 2, 0, dist), std::invalid_argument);
+    EXPECT_THROW(graph.decreaseEdgeWeight(0, 7, 0, dist), std::invalid_argument);
+    EXPECT_THROW(graph.addEdge(-1, 2, 0, dist), std::invalid_argument);
+    EXPECT_EQ(dist[0][2], 3);
+
+    testing::internal::CaptureStdout();
+    EXPECT_FALSE(graph.decreaseEdgeWeight(0, 1, -3, dist));
+    std::string output = testing::internal::GetCapturedStdout();
+    EXPECT_FALSE(output.empty());
+    EXPECT_EQ(dist[0][0], INF);
+}
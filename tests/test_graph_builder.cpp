@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <thread>
+#include <tuple>
+#include "../include/graph_builder.h"
+#include "../include/constants.h"
+
+namespace {
+    using EdgeTuple = std::tuple<int, int, double>;
+
+    std::vector<EdgeTuple> edgesOf(const Graph& graph) {
+        std::shared_ptr<const CSRGraph> csr = graph.getCSR();
+        std::vector<EdgeTuple> edges;
+        for (int u = 0; u < csr->getV(); u++) {
+            for (size_t i = csr->edgesBegin(u); i < csr->edgesEnd(u); i++) {
+                edges.emplace_back(u, csr->getTargets()[i], csr->getWeights()[i]);
+            }
+        }
+        return edges;
+    }
+
+    std::vector<EdgeTuple> randomEdges(int V, size_t count, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<int> vertex(0, V - 1);
+        std::uniform_real_distribution<double> weight(0.0, 10.0);
+        std::vector<EdgeTuple> edges;
+        for (size_t k = 0; k < count; k++) {
+            int u = vertex(rng), v = vertex(rng);
+            edges.emplace_back(u, v, u < v ? weight(rng) - 2.0 : weight(rng));
+        }
+        return edges;
+    }
+}
+
+TEST(GraphBuilderTest, MatchesAddEdge) {
+    std::vector<EdgeTuple> edges = randomEdges(40, 120, 1);
+    Graph expected(40);
+    GraphBuilder builder(40, 1);
+    builder.reserve(edges.size());
+    for (const auto& e : edges) {
+        expected.addEdge(std::get<0>(e), std::get<1>(e), std::get<2>(e));
+        builder.addEdge(std::get<0>(e), std::get<1>(e), std::get<2>(e));
+    }
+    Graph actual = builder.build();
+    EXPECT_TRUE(builder.getReport().ok());
+    EXPECT_EQ(builder.getReport().edges, edges.size());
+
+    expected.setStrategy(std::make_unique<SequentialStrategy>());
+    actual.setStrategy(std::make_unique<SequentialStrategy>());
+    DistanceMatrix a = actual.johnson();
+    DistanceMatrix b = expected.johnson();
+    for (int i = 0; i < 40; i++) {
+        for (int j = 0; j < 40; j++) {
+            if (b[i][j] == INF) {
+                EXPECT_EQ(a[i][j], INF);
+            } else {
+                EXPECT_NEAR(a[i][j], b[i][j], 1e-9);
+            }
+        }
+    }
+}
+
+TEST(GraphBuilderTest, ConcurrentBatchesKeepAllEdges) {
+    const int V = 1000;
+    const int threads = 4;
+    std::vector<EdgeTuple> edges = randomEdges(V, 200000, 2);
+
+    GraphBuilder builder(V, threads);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&, t]() {
+            std::vector<int> src, dst;
+            std::vector<double> weight;
+            for (size_t k = t; k < edges.size(); k += threads) {
+                src.push_back(std::get<0>(edges[k]));
+                dst.push_back(std::get<1>(edges[k]));
+                weight.push_back(std::get<2>(edges[k]));
+            }
+            builder.reserve(src.size());
+            // Кілька пакетів з одного потоку потрапляють в один буфер
+            size_t half = src.size() / 2;
+            builder.addEdges(src.data(), dst.data(), weight.data(), half);
+            builder.addEdges(src.data() + half, dst.data() + half, weight.data() + half, src.size() - half);
+        });
+    }
+    for (auto& worker : workers) worker.join();
+
+    Graph graph = builder.build();
+    EXPECT_EQ(builder.getReport().edges, edges.size());
+
+    std::vector<EdgeTuple> actual = edgesOf(graph);
+    std::sort(actual.begin(), actual.end());
+    std::sort(edges.begin(), edges.end());
+    EXPECT_EQ(actual, edges);
+}
+
+TEST(GraphBuilderTest, SingleThreadKeepsInsertionOrder) {
+    const int V = 5000;
+    std::vector<EdgeTuple> edges = randomEdges(V, 300000, 3);
+    Graph expected(V);
+    GraphBuilder builder(V, 4);
+    for (const auto& e : edges) {
+        expected.addEdge(std::get<0>(e), std::get<1>(e), std::get<2>(e));
+        builder.addEdge(std::get<0>(e), std::get<1>(e), std::get<2>(e));
+    }
+    Graph actual = builder.build();
+    EXPECT_EQ(edgesOf(actual), edgesOf(expected));
+}
+
+TEST(GraphBuilderTest, RejectedEdgesAreReported) {
+    GraphBuilder builder(3, 2);
+    int src[] = {0, 5, 1, -1};
+    int dst[] = {1, 0, 2, 2};
+    double weight[] = {1.0, 2.0, std::numeric_limits<double>::quiet_NaN(), 3.0};
+    builder.addEdges(src, dst, weight, 4);
+    Graph graph = builder.build();
+
+    const BuildReport& report = builder.getReport();
+    EXPECT_FALSE(report.ok());
+    EXPECT_EQ(report.edges, 1u);
+    EXPECT_EQ(report.rejected, 3u);
+    ASSERT_EQ(report.errors.size(), 3u);
+    EXPECT_EQ(report.errors[0], "edge 5 -> 0: vertex is out of range");
+    EXPECT_EQ(report.errors[1], "edge 1 -> 2: weight is not a finite number");
+    EXPECT_EQ(graph.getCSR()->getEdgeCount(), 1u);
+}
+
+TEST(GraphBuilderTest, BuilderIsEmptyAfterBuild) {
+    GraphBuilder builder(2, 1);
+    builder.addEdge(0, 1, 1.0);
+    Graph first = builder.build();
+    builder.addEdge(1, 0, 2.0);
+    Graph second = builder.build();
+
+    EXPECT_EQ(first.getCSR()->getEdgeCount(), 1u);
+    ASSERT_EQ(second.getCSR()->getEdgeCount(), 1u);
+    EXPECT_EQ(second.getCSR()->getTargets()[0], 0);
+}
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include "../include/graph.h"
+#include "../include/graph_file.h"
+#include "../include/constants.h"
+#include "test_helpers.h"
+
+class GraphFileTest : public TempFileTest {};
+
+TEST_F(GraphFileTest, RoundTripGivesSameDistances) {
+    Graph original = makeRandomGraph(40, 3);
+    DistanceMatrix expected = expectedMatrix(original);
+    original.saveBinary(path);
+
+    Graph loaded = Graph::loadBinary(path);
+    loaded.setStrategy(std::make_unique<SequentialStrategy>());
+    EXPECT_EQ(loaded.getV(), 40);
+    EXPECT_EQ(loaded.getCSR()->getEdgeCount(), original.getCSR()->getEdgeCount());
+    expectSameMatrix(loaded.johnson(), expected);
+
+    // Перестановка вершин будує граф з CSR, а не зі списків суміжності
+    loaded.setVertexOrdering(VertexOrdering::ReverseCuthillMcKee);
+    expectSameMatrix(loaded.johnson(), expected);
+}
+
+TEST_F(GraphFileTest, ChangingLoadedGraphExpandsAdjacencyLists) {
+    Graph original(3);
+    original.addEdge(0, 1, 4.0);
+    original.addEdge(1, 2, -1.0);
+    original.saveBinary(path);
+
+    Graph loaded = Graph::loadBinary(path);
+    loaded.setStrategy(std::make_unique<SequentialStrategy>());
+    loaded.addEdge(2, 0, 2.0);
+
+    const auto& adj = loaded.getAdj();
+    ASSERT_EQ(adj[0].size(), 1u);
+    EXPECT_EQ(adj[0][0].dest, 1);
+    EXPECT_EQ(adj[2].size(), 1u);
+
+    DistanceMatrix dist = loaded.johnson();
+    EXPECT_DOUBLE_EQ(dist[0][2], 3.0);
+    EXPECT_DOUBLE_EQ(dist[2][1], 6.0);
+}
+
+TEST_F(GraphFileTest, InvalidFilesAreRejected) {
+    EXPECT_THROW(Graph::loadBinary(path + ".missing"), std::runtime_error);
+
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "this is not a graph file, only some text of sufficient length";
+    }
+    EXPECT_THROW(Graph::loadBinary(path), std::runtime_error);
+
+    // Обрізаний файл з правильним заголовком
+    Graph original = makeRandomGraph(20, 5);
+    original.saveBinary(path);
+    std::string content;
+    {
+        std::ifstream in(path, std::ios::binary);
+        content.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(content.data(), content.size() / 2);
+    }
+    EXPECT_THROW(Graph::loadBinary(path), std::runtime_error);
+
+    // Кількість ребер, для якої розмір масивів переповнює 64 біти
+    const uint64_t huge = uint64_t(1) << 62;
+    std::string forged = content;
+    std::memcpy(&forged[offsetof(GraphFileHeader, edges)], &huge, sizeof(huge));
+    std::memcpy(&forged[sizeof(GraphFileHeader) + 20 * sizeof(uint64_t)], &huge, sizeof(huge));
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(forged.data(), forged.size());
+    }
+    EXPECT_THROW(Graph::loadBinary(path), std::runtime_error);
+}
+
+TEST_F(GraphFileTest, MappedGraphOutlivesGraphObject) {
+    Graph original = makeRandomGraph(10, 7);
+    original.saveBinary(path);
+
+    std::shared_ptr<const CSRGraph> csr;
+    {
+        Graph loaded = Graph::loadBinary(path);
+        csr = loaded.getCSR();
+    }
+    // Відображення тримає сам CSR, тому масиви лишаються доступними
+    std::shared_ptr<const CSRGraph> expected = original.getCSR();
+    ASSERT_EQ(csr->getEdgeCount(), expected->getEdgeCount());
+    for (size_t i = 0; i < csr->getEdgeCount(); i++) {
+        EXPECT_EQ(csr->getTargets()[i], expected->getTargets()[i]);
+        EXPECT_EQ(csr->getWeights()[i], expected->getWeights()[i]);
+    }
+}
@@ -0,0 +1,209 @@
+#include <gtest/gtest.h>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include "../include/graph_loader.h"
+#include "../include/constants.h"
+#include "test_helpers.h"
+
+namespace {
+    void expectSameEdges(const Graph& actual, const Graph& expected) {
+        std::shared_ptr<const CSRGraph> a = actual.getCSR();
+        std::shared_ptr<const CSRGraph> b = expected.getCSR();
+        ASSERT_EQ(a->getV(), b->getV());
+        ASSERT_EQ(a->getEdgeCount(), b->getEdgeCount());
+        for (int u = 0; u <= a->getV(); u++) {
+            EXPECT_EQ(a->getOffsets()[u], b->getOffsets()[u]);
+        }
+        for (size_t i = 0; i < a->getEdgeCount(); i++) {
+            EXPECT_EQ(a->getTargets()[i], b->getTargets()[i]);
+            EXPECT_DOUBLE_EQ(a->getWeights()[i], b->getWeights()[i]);
+        }
+    }
+}
+
+TEST(GraphLoaderTest, ParsesDimacs) {
+    GraphLoader loader(1);
+    Graph graph = loader.parse("c example\np sp 3 3\na 1 2 4\nc middle\na 2 3 -1.5\r\na 3 1 2e0\n", GraphFormat::Auto);
+
+    EXPECT_EQ(loader.getLastReport().format, GraphFormat::Dimacs);
+    EXPECT_TRUE(loader.getLastReport().ok());
+    EXPECT_EQ(loader.getLastReport().edges, 3u);
+    EXPECT_EQ(loader.getLastReport().lines, 6u);
+    ASSERT_EQ(graph.getV(), 3);
+    graph.setStrategy(std::make_unique<SequentialStrategy>());
+    DistanceMatrix dist = graph.johnson();
+    EXPECT_DOUBLE_EQ(dist[0][2], 2.5);
+    EXPECT_DOUBLE_EQ(dist[2][1], 6.0);
+}
+
+TEST(GraphLoaderTest, ParsesCsvWithHeader) {
+    GraphLoader loader(1);
+    Graph graph = loader.parse("src,dst,weight\n0,1,1.5\n# comment\n1 , 4 , 2\n", GraphFormat::Csv);
+
+    // Рядок з назвами стовпців не є ребром, тому він потрапляє у звіт
+    const LoadReport& report = loader.getLastReport();
+    EXPECT_EQ(report.skipped, 1u);
+    ASSERT_EQ(report.errors.size(), 1u);
+    EXPECT_EQ(report.errors[0], "line 1: expected two vertex ids");
+    EXPECT_EQ(report.edges, 2u);
+    EXPECT_EQ(graph.getV(), 5);
+    const auto& adj = graph.getAdj();
+    ASSERT_EQ(adj[1].size(), 1u);
+    EXPECT_EQ(adj[1][0].dest, 4);
+    EXPECT_DOUBLE_EQ(adj[1][0].weight, 2.0);
+
+    // Зіпсований перший рядок даних так само пропускається і рахується
+    loader.parse("0;1;1.5\n1,2,1\n", GraphFormat::Csv);
+    EXPECT_EQ(loader.getLastReport().skipped, 1u);
+    EXPECT_EQ(loader.getLastReport().edges, 1u);
+}
+
+TEST(GraphLoaderTest, SparseCsvIdsAreRejectedOrCompacted) {
+    GraphLoader loader(1);
+    const std::string text = "0,2000000000,1\n2000000000,70,2.5\n";
+    EXPECT_THROW(loader.parse(text, GraphFormat::Csv), std::runtime_error);
+
+    loader.setCompactIds(true);
+    Graph graph = loader.parse(text, GraphFormat::Csv);
+    const LoadReport& report = loader.getLastReport();
+    EXPECT_TRUE(report.ok());
+    EXPECT_EQ(report.vertex_ids, (std::vector<long long>{0, 70, 2000000000}));
+    ASSERT_EQ(graph.getV(), 3);
+    const auto& adj = graph.getAdj();
+    ASSERT_EQ(adj[0].size(), 1u);
+    EXPECT_EQ(adj[0][0].dest, 2);
+    ASSERT_EQ(adj[2].size(), 1u);
+    EXPECT_EQ(adj[2][0].dest, 1);
+    EXPECT_DOUBLE_EQ(adj[2][0].weight, 2.5);
+
+    // Дрібні шматки перенумеровуються паралельно з тим самим результатом
+    std::string many;
+    for (int i = 0; i < 2000; i++) {
+        many += std::to_string(1000000007LL * (i % 97)) + "," + std::to_string(1000000007LL * ((i * 31) % 89)) + ",1\n";
+    }
+    GraphLoader sequential(1), parallel(4);
+    sequential.setCompactIds(true);
+    parallel.setCompactIds(true);
+    parallel.setChunkSize(256);
+    Graph expected = sequential.parse(many, GraphFormat::Csv);
+    Graph actual = parallel.parse(many, GraphFormat::Csv);
+    EXPECT_EQ(parallel.getLastReport().vertex_ids, sequential.getLastReport().vertex_ids);
+    expectSameEdges(actual, expected);
+
+    // З оголошеною кількістю вершин номери не змінюються
+    parallel.parse("p sp 3 1\na 1 3 1\n", GraphFormat::Dimacs);
+    EXPECT_TRUE(parallel.getLastReport().vertex_ids.empty());
+}
+
+TEST(GraphLoaderTest, ParsesSymmetricMatrixMarket) {
+    GraphLoader loader(1);
+    Graph graph = loader.parse("%%MatrixMarket matrix coordinate pattern symmetric\n% comment\n4 4 2\n2 1\n3 3\n",
+                               GraphFormat::Auto);
+
+    EXPECT_EQ(loader.getLastReport().format, GraphFormat::MatrixMarket);
+    EXPECT_EQ(graph.getV(), 4);
+    // Недіагональний елемент дає ребра в обидва боки, діагональний - одну петлю
+    EXPECT_EQ(loader.getLastReport().edges, 3u);
+    const auto& adj = graph.getAdj();
+    ASSERT_EQ(adj[0].size(), 1u);
+    EXPECT_EQ(adj[0][0].dest, 1);
+    EXPECT_DOUBLE_EQ(adj[0][0].weight, 1.0);
+    EXPECT_EQ(adj[1].size(), 1u);
+    EXPECT_EQ(adj[2].size(), 1u);
+}
+
+TEST(GraphLoaderTest, CollectsErrorsWithLineNumbers) {
+    GraphLoader loader(1);
+    Graph graph = loader.parse("p sp 2 4\na 1 2 1\na 1 x 1\na 1 3 1\nq\na 2 1 nan\n", GraphFormat::Dimacs);
+
+    const LoadReport& report = loader.getLastReport();
+    EXPECT_EQ(report.edges, 1u);
+    EXPECT_EQ(report.skipped, 4u);
+    ASSERT_EQ(report.errors.size(), 4u);
+    EXPECT_EQ(report.errors[0], "line 3: expected two vertex ids");
+    EXPECT_EQ(report.errors[1], "line 4: vertex is out of range");
+    EXPECT_EQ(report.errors[2], "line 5: unknown line type");
+    EXPECT_EQ(report.errors[3], "line 6: weight is not a finite number");
+    EXPECT_EQ(graph.getV(), 2);
+}
+
+TEST(GraphLoaderTest, InvalidHeadersThrow) {
+    GraphLoader loader(1);
+    EXPECT_THROW(loader.parse("a 1 2 3\n", GraphFormat::Dimacs), std::runtime_error);
+    EXPECT_THROW(loader.parse("%%MatrixMarket matrix array real general\n2 2\n", GraphFormat::MatrixMarket),
+                 std::runtime_error);
+    EXPECT_THROW(loader.load("/nonexistent/graph.gr"), std::runtime_error);
+}
+
+TEST(GraphLoaderTest, ParallelChunksMatchSequentialParse) {
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> vertex(1, 500);
+    std::uniform_real_distribution<double> weight(-1.0, 10.0);
+    std::ostringstream text;
+    text << "p sp 500 20000\n";
+    for (int k = 0; k < 20000; k++) {
+        if (k % 1000 == 0) text << "c block " << k << "\n";
+        if (k == 12345) text << "a broken line\n";
+        text << "a " << vertex(rng) << " " << vertex(rng) << " " << weight(rng) << "\n";
+    }
+
+    GraphLoader sequential(1);
+    Graph expected = sequential.parse(text.str(), GraphFormat::Dimacs);
+
+    GraphLoader parallel(4);
+    parallel.setChunkSize(4096);
+    Graph actual = parallel.parse(text.str(), GraphFormat::Dimacs);
+
+    EXPECT_EQ(parallel.getLastReport().edges, 20000u);
+    EXPECT_EQ(parallel.getLastReport().lines, sequential.getLastReport().lines);
+    ASSERT_EQ(parallel.getLastReport().errors.size(), 1u);
+    EXPECT_EQ(parallel.getLastReport().errors, sequential.getLastReport().errors);
+    expectSameEdges(actual, expected);
+}
+
+class GraphLoaderFileTest : public TempFileTest {};
+
+TEST_F(GraphLoaderFileTest, LoadsFileByExtension) {
+    std::string csv = tempPath(".csv");
+    {
+        std::ofstream out(csv);
+        out << "0,1,3\n1,2,4\n";
+    }
+    GraphLoader loader(2);
+    Graph graph = loader.load(csv);
+
+    EXPECT_EQ(loader.getLastReport().format, GraphFormat::Csv);
+    EXPECT_EQ(graph.getV(), 3);
+    EXPECT_EQ(loader.getLastReport().edges, 2u);
+}
+
+TEST_F(GraphLoaderFileTest, LoadedFileMatchesParsedText) {
+    std::ostringstream text;
+    text << "%%MatrixMarket matrix coordinate real general\n300 300 3000\n";
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<int> vertex(1, 300);
+    for (int k = 0; k < 3000; k++) {
+        text << vertex(rng) << " " << vertex(rng) << " " << k % 17;
+        // Останній рядок без переведення рядка закінчується разом із файлом
+        if (k + 1 < 3000) text << "\n";
+    }
+    std::string mtx = tempPath(".mtx");
+    {
+        std::ofstream out(mtx, std::ios::binary);
+        out << text.str();
+    }
+    GraphLoader loader(4);
+    loader.setChunkSize(1024);
+    Graph loaded = loader.load(mtx);
+    EXPECT_EQ(loader.getLastReport().edges, 3000u);
+    EXPECT_TRUE(loader.getLastReport().ok());
+    Graph parsed = GraphLoader(1).parse(text.str(), GraphFormat::MatrixMarket);
+    expectSameEdges(loaded, parsed);
+
+    // Порожній файл дає граф без вершин
+    std::string empty = tempPath(".csv");
+    std::ofstream(empty).close();
+    EXPECT_EQ(loader.load(empty).getV(), 0);
+}
@@ -0,0 +1,106 @@
+#pragma once
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "../include/constants.h"
+#include "../include/distance_matrix.h"
+#include "../include/graph.h"
+
+/**
+ * @brief random graph without cycles of negative weight
+ * @param V number of vertices
+ * @param seed seed of the generator
+ * @param E number of edges, 0 means 3 * V
+ * @param shift the value subtracted from the weights in [0, 10) of the edges u -> v with u < v
+ * @return the graph without a strategy
+ */
+inline Graph makeRandomGraph(int V, unsigned seed, size_t E = 0, double shift = 2.0) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> vertex(0, V - 1);
+    std::uniform_real_distribution<double> weight(0.0, 10.0);
+    Graph g(V);
+    if (E == 0) E = 3 * static_cast<size_t>(V);
+    for (size_t k = 0; k < E; k++) {
+        int u = vertex(rng), v = vertex(rng);
+        g.addEdge(u, v, u < v ? weight(rng) - shift : weight(rng));
+    }
+    return g;
+}
+
+///@brief random graph with integer weights in [-3, 10], which may contain cycles of negative weight
+inline Graph makeRandomIntegerGraph(int V, size_t E, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> vertex(0, V - 1);
+    std::uniform_int_distribution<int> weight(-3, 10);
+    Graph g(V);
+    for (size_t k = 0; k < E; k++) {
+        g.addEdge(vertex(rng), vertex(rng), weight(rng));
+    }
+    return g;
+}
+
+///@return the distances computed by the sequential strategy, which is left set on the graph
+inline DistanceMatrix expectedMatrix(Graph& graph) {
+    graph.setStrategy(std::make_unique<SequentialStrategy>());
+    return graph.johnson();
+}
+
+///@brief checking one distance, INF must match exactly
+inline void expectSameDistance(double actual, double expected, double tolerance = 1e-9) {
+    if (expected == INF) {
+        EXPECT_EQ(actual, INF);
+    } else {
+        EXPECT_NEAR(actual, expected, tolerance);
+    }
+}
+
+/**
+ * @brief checking one row against a row of the expected matrix
+ * @param actual anything indexed by the column: a pointer, a vector or a row of a DistanceMatrix
+ * @param expected the expected matrix
+ * @param row the row of the expected matrix
+ * @param tolerance the allowed difference of finite distances
+ */
+template <typename Row>
+void expectRow(const Row& actual, const DistanceMatrix& expected, int row, double tolerance = 1e-9) {
+    for (int j = 0; j < expected.getCols(); j++) {
+        expectSameDistance(actual[j], expected[row][j], tolerance);
+    }
+}
+
+inline void expectSameMatrix(const DistanceMatrix& actual, const DistanceMatrix& expected, double tolerance = 1e-9) {
+    ASSERT_EQ(actual.getRows(), expected.getRows());
+    ASSERT_EQ(actual.getCols(), expected.getCols());
+    for (int i = 0; i < expected.getRows(); i++) {
+        expectRow(actual[i], expected, i, tolerance);
+    }
+}
+
+///@brief fixture which names files in the temporary directory after the test and removes them with it
+class TempFileTest : public ::testing::Test {
+protected:
+    std::string path;  // файл з розширенням .bin, який створюється для кожного тесту
+    std::vector<std::string> created;
+
+    ///@return a further file with the given extension, e.g. ".csv", removed with the test
+    std::string tempPath(const std::string& extension) {
+        const ::testing::TestInfo* info = ::testing::UnitTest::GetInstance()->current_test_info();
+        std::string file = ::testing::TempDir() + info->test_suite_name() + "_" + info->name() + "_" +
+                           std::to_string(created.size()) + extension;
+        created.push_back(file);
+        return file;
+    }
+
+    void SetUp() override {
+        path = tempPath(".bin");
+    }
+
+    void TearDown() override {
+        for (const std::string& file : created) {
+            std::remove(file.c_str());
+        }
+    }
+};
@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include "../include/lazy_distance_matrix.h"
+#include "../include/constants.h"
+#include "test_helpers.h"
+
+TEST(LazyDistanceMatrixTest, RowsMatchJohnson) {
+    Graph graph = makeRandomGraph(30, 1);
+    DistanceMatrix expected = expectedMatrix(graph);
+    LazyDistanceMatrix lazy = graph.lazyJohnson(4);
+
+    EXPECT_EQ(lazy.size(), 30);
+    for (int src = 29; src >= 0; src--) {
+        auto row = lazy.row(src);
+        ASSERT_EQ(row->size(), 30u);
+        expectRow(*row, expected, src);
+    }
+    EXPECT_NEAR(lazy.at(3, 7), expected[3][7], 1e-9);
+    EXPECT_THROW(lazy.row(30), std::invalid_argument);
+}
+
+TEST(LazyDistanceMatrixTest, LeastRecentlyUsedRowsAreEvicted) {
+    Graph graph = makeRandomGraph(10, 2);
+    LazyDistanceMatrix lazy = graph.lazyJohnson(2);
+
+    auto first = lazy.row(0);
+    lazy.row(1);
+    EXPECT_EQ(lazy.row(0), first);  // 0 знову найновіший
+    lazy.row(2);
+
+    EXPECT_EQ(lazy.getCachedRowCount(), 2u);
+    EXPECT_TRUE(lazy.isCached(0));
+    EXPECT_FALSE(lazy.isCached(1));
+    EXPECT_TRUE(lazy.isCached(2));
+    // Витіснений рядок лишається дійсним для того, хто його тримає
+    EXPECT_EQ(first->size(), 10u);
+}
+
+TEST(LazyDistanceMatrixTest, PrefetchOnPool) {
+    Graph graph = makeRandomGraph(40, 3);
+    DistanceMatrix expected = expectedMatrix(graph);
+    auto pool = std::make_shared<ThreadPool>(2);
+    LazyDistanceMatrix lazy = graph.lazyJohnson(40, pool);
+
+    lazy.prefetch({5, 6, 7, 5});
+    for (int src : {5, 6, 7}) {
+        auto row = lazy.row(src);
+        EXPECT_TRUE(lazy.isCached(src));
+        expectRow(*row, expected, src);
+    }
+    EXPECT_EQ(lazy.getCachedRowCount(), 3u);
+}
+
+TEST(LazyDistanceMatrixTest, NegativeCycleGivesInfiniteRows) {
+    Graph graph(3);
+    graph.addEdge(0, 1, 1);
+    graph.addEdge(1, 0, -2);
+
+    testing::internal::CaptureStdout();
+    LazyDistanceMatrix lazy = graph.lazyJohnson(2);
+    testing::internal::GetCapturedStdout();
+    EXPECT_EQ(lazy.at(0, 0), INF);
+}
+
+TEST(LazyDistanceMatrixTest, RowFromPoolTaskDoesNotWaitForPrefetch) {
+    Graph graph = makeRandomGraph(20, 4);
+    DistanceMatrix expected = expectedMatrix(graph);
+    auto pool = std::make_shared<ThreadPool>(1);
+    LazyDistanceMatrix lazy = graph.lazyJohnson(20, pool);
+
+    // Єдиний воркер виконує це завдання, тож prefetch рядка 3 стоїть у черзі за ним
+    auto result = pool->enqueue([&lazy]() {
+        lazy.prefetch({3});
+        return lazy.row(3);
+    });
+    auto row = result.get();
+    expectRow(*row, expected, 3);
+    EXPECT_EQ(lazy.row(3)->size(), 20u);
+}
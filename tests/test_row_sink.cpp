@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include "../include/row_sink.h"
+#include "../include/auto_strategy.h"
+#include "../include/constants.h"
+#include "test_helpers.h"
+
+TEST(RowSinkTest, CallbackReceivesEveryRowOnce) {
+    Graph graph = makeRandomGraph(200, 1);
+    DistanceMatrix expected = expectedMatrix(graph);
+    graph.setStrategy(std::make_unique<ParallelDijkstraStrategy>(4));
+
+    std::vector<int> seen(200, 0);
+    CallbackRowSink sink([&](int row, const double* values, int cols) {
+        ASSERT_EQ(cols, 200);
+        seen[row]++;
+        expectRow(values, expected, row, 1e-9);
+    });
+    graph.johnson(sink);
+    EXPECT_EQ(seen, std::vector<int>(200, 1));
+}
+
+TEST(RowSinkTest, TsvRowsAreWrittenInOrder) {
+    Graph graph = makeRandomGraph(150, 2);
+    DistanceMatrix expected = expectedMatrix(graph);
+    graph.setStrategy(std::make_unique<ParallelDijkstraStrategy>(4));
+
+    std::ostringstream out;
+    TsvRowSink sink(out, true);
+    graph.johnson(sink);
+
+    std::istringstream in(out.str());
+    std::string line;
+    int row = 0;
+    while (std::getline(in, line)) {
+        std::istringstream cells(line);
+        std::string cell;
+        std::vector<double> values;
+        while (std::getline(cells, cell, '\t')) {
+            values.push_back(cell == "INF" ? INF : std::stod(cell));
+        }
+        ASSERT_EQ(values.size(), 150u);
+        expectRow(values.data(), expected, row, 1e-9);
+        row++;
+    }
+    EXPECT_EQ(row, 150);
+}
+
+TEST(RowSinkTest, PrintMatrixWritesTabSeparatedRows) {
+    Graph graph(3);
+    graph.addEdge(0, 1, 1.5);
+    graph.addEdge(1, 2, -0.25);
+    graph.addEdge(0, 2, 2.0);
+    graph.setStrategy(std::make_unique<SequentialStrategy>());
+
+    // Формат як у std::ostream: шість значущих цифр, після кожного значення табуляція
+    testing::internal::CaptureStdout();
+    graph.printMatrix();
+    EXPECT_EQ(testing::internal::GetCapturedStdout(),
+              "Matrix of the shortest paths:\n"
+              "0\t1.5\t1.25\t\n"
+              "INF\t0\t-0.25\t\n"
+              "INF\tINF\t0\t\n");
+
+    // Точний запис лише на вимогу, наприклад для файлу, який читатимуть назад
+    Graph third(2);
+    third.addEdge(0, 1, 1.0 / 3);
+    third.setStrategy(std::make_unique<SequentialStrategy>());
+    std::ostringstream printed, exact;
+    TsvRowSink print_sink(printed), exact_sink(exact, true);
+    third.johnson(print_sink);
+    third.johnson(exact_sink);
+    EXPECT_EQ(printed.str(), "0\t0.333333\t\nINF\t0\t\n");
+    EXPECT_EQ(std::stod(exact.str().substr(2)), 1.0 / 3);
+}
+
+class RowSinkFileTest : public TempFileTest {};
+
+TEST_F(RowSinkFileTest, BinaryFileHoldsTheMatrix) {
+    Graph graph = makeRandomGraph(120, 3);
+    DistanceMatrix expected = expectedMatrix(graph);
+    auto strategy = std::make_unique<AutoStrategy>(3);
+    strategy->setLogging(false);
+    graph.setStrategy(std::move(strategy));
+
+    for (DistancePrecision precision : {DistancePrecision::Double, DistancePrecision::Float}) {
+        // Маленький буфер, щоб рядки записувались кількома частинами
+        BinaryFileRowSink sink(path, precision, 3000);
+        graph.johnson(sink);
+
+        std::ifstream in(path, std::ios::binary);
+        DistanceFileHeader header;
+        in.read(reinterpret_cast<char*>(&header), sizeof(header));
+        EXPECT_EQ(std::memcmp(header.magic, "JDIST", 5), 0);
+        EXPECT_EQ(header.rows, 120u);
+        EXPECT_EQ(header.cols, 120u);
+        std::vector<double> row(120);
+        for (int i = 0; i < 120; i++) {
+            if (precision == DistancePrecision::Float) {
+                ASSERT_EQ(header.element_size, sizeof(float));
+                std::vector<float> stored(120);
+                in.read(reinterpret_cast<char*>(stored.data()), 120 * sizeof(float));
+                for (int j = 0; j < 120; j++) row[j] = stored[j];
+                expectRow(row.data(), expected, i, 1e-4);
+            } else {
+                ASSERT_EQ(header.element_size, sizeof(double));
+                in.read(reinterpret_cast<char*>(row.data()), 120 * sizeof(double));
+                expectRow(row.data(), expected, i, 1e-9);
+            }
+        }
+        EXPECT_TRUE(in.good());
+    }
+}
+
+TEST(RowSinkTest, NegativeCycleGivesInfRows) {
+    Graph graph(3);
+    graph.addEdge(0, 1, 1.0);
+    graph.addEdge(1, 0, -2.0);
+    graph.setStrategy(std::make_unique<ParallelDijkstraStrategy>(2));
+
+    int rows = 0;
+    CallbackRowSink sink([&](int, const double* values, int cols) {
+        rows++;
+        for (int j = 0; j < cols; j++) EXPECT_EQ(values[j], INF);
+    });
+    graph.johnson(sink);
+    EXPECT_EQ(rows, 3);
+}
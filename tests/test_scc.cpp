@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "../include/graph.h"
+#include "../include/scc.h"
+#include "../include/constants.h"
+#include "test_helpers.h"
+
+namespace {
+    // Майже ациклічний граф: ребра вперед з від'ємними вагами і кілька зворотних ребер, що утворюють цикли
+    Graph makeLayeredGraph(int V, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<int> vertex(0, V - 1);
+        std::uniform_real_distribution<double> weight(-2.0, 10.0);
+        std::uniform_real_distribution<double> chance(0.0, 1.0);
+        Graph g(V);
+        for (int k = 0; k < 2 * V; k++) {
+            int u = vertex(rng), v = vertex(rng);
+            if (u == v) continue;
+            if (u > v) std::swap(u, v);
+            if (chance(rng) < 0.15) {
+                g.addEdge(v, u, weight(rng) + 12.0);
+            } else {
+                g.addEdge(u, v, weight(rng));
+            }
+        }
+        return g;
+    }
+}
+
+TEST(SccTest, ComponentsInTopologicalOrder) {
+    Graph graph(6);
+    graph.addEdge(0, 1, 1);
+    graph.addEdge(1, 0, 1);
+    graph.addEdge(1, 2, 1);
+    graph.addEdge(2, 3, 1);
+    graph.addEdge(3, 4, 1);
+    graph.addEdge(4, 2, 1);
+    graph.addEdge(5, 0, 1);
+
+    Condensation scc = condense(*graph.getCSR());
+    EXPECT_EQ(scc.count, 3);
+    EXPECT_EQ(scc.component[0], scc.component[1]);
+    EXPECT_EQ(scc.component[2], scc.component[4]);
+    EXPECT_EQ(scc.size(scc.component[2]), 3u);
+    EXPECT_EQ(scc.component[5], 0);
+
+    auto csr = graph.getCSR();
+    for (int u = 0; u < 6; u++) {
+        for (size_t i = csr->edgesBegin(u); i < csr->edgesEnd(u); i++) {
+            EXPECT_LE(scc.component[u], scc.component[csr->getTargets()[i]]);
+        }
+    }
+}
+
+TEST(SccTest, JohnsonMatchesWithoutDecomposition) {
+    for (unsigned seed = 0; seed < 10; seed++) {
+        Graph graph = makeLayeredGraph(50, seed);
+        DistanceMatrix expected = expectedMatrix(graph);
+
+        for (HeapType heap : {HeapType::IndexedFibonacci, HeapType::QuaternaryHeap}) {
+            std::unique_ptr<ParallelizationStrategy> strategies[] = {
+                    std::make_unique<SequentialStrategy>(),
+                    std::make_unique<ParallelDijkstraStrategy>(2)
+            };
+            for (auto& strategy : strategies) {
+                strategy->setHeapType(heap);
+                strategy->setSccDecomposition(true);
+                graph.setStrategy(std::move(strategy));
+                DistanceMatrix result = graph.johnson();
+
+                expectSameMatrix(result, expected);
+            }
+        }
+    }
+}
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "../include/thread_pool.h"
+
+TEST(ThreadPoolTest, EnqueueReturnsResult) {
+    ThreadPool pool(2);
+    auto result = pool.enqueue([](int a, int b) { return a + b; }, 2, 3);
+    EXPECT_EQ(result.get(), 5);
+}
+
+TEST(ThreadPoolTest, ParallelForVisitsEveryIndexOnce) {
+    ThreadPool pool(4);
+    std::vector<std::atomic<int>> visits(1000);
+    for (auto& v : visits) v = 0;
+
+    pool.parallelFor(0, visits.size(), [&](size_t i) { visits[i]++; });
+
+    for (auto& v : visits) {
+        EXPECT_EQ(v.load(), 1);
+    }
+}
+
+TEST(ThreadPoolTest, ParallelForGrainAndGuidedSchedule) {
+    ThreadPool pool(4);
+    for (Schedule schedule : {Schedule::Stealing, Schedule::Guided}) {
+        for (size_t grain : {0, 1, 7, 5000}) {
+            std::vector<std::atomic<int>> visits(1000);
+            for (auto& v : visits) v = 0;
+
+            pool.parallelFor(3, visits.size(), [&](size_t i) { visits[i]++; }, grain, schedule);
+
+            EXPECT_EQ(visits[0].load(), 0);
+            for (size_t i = 3; i < visits.size(); i++) {
+                EXPECT_EQ(visits[i].load(), 1) << "grain " << grain;
+            }
+        }
+    }
+}
+
+TEST(ThreadPoolTest, NestedParallelFor) {
+    ThreadPool pool(2);
+    std::atomic<int> total{0};
+
+    // Внутрішній parallelFor виконується з завдання того ж пулу
+    pool.parallelFor(0, 8, [&](size_t) {
+        pool.parallelFor(0, 100, [&](size_t) { total++; }, 0, Schedule::Guided);
+    });
+    EXPECT_EQ(total.load(), 800);
+}
+
+TEST(ThreadPoolTest, ParallelForRethrowsException) {
+    ThreadPool pool(3);
+    EXPECT_THROW(pool.parallelFor(0, 100, [](size_t i) {
+        if (i == 42) throw std::runtime_error("failure");
+    }), std::runtime_error);
+}
+
+TEST(ThreadPoolTest, ParallelForCallerRunsOnlyItsOwnTasks) {
+    ThreadPool pool(1);
+    std::promise<void> release;
+    std::shared_future<void> gate = release.get_future().share();
+    std::atomic<bool> started{false};
+    auto blocker = pool.enqueue([gate, &started]() {
+        started = true;
+        gate.wait();
+    });
+    while (!started) std::this_thread::yield();
+
+    // Єдиний воркер зайнятий, тож усі шматки виконує потік, що викликав, а чуже завдання лишається в черзі
+    std::atomic<bool> other_ran{false};
+    auto other = pool.enqueue([&other_ran]() { other_ran = true; });
+    std::atomic<int> total{0};
+    pool.parallelFor(0, 100, [&](size_t) { total++; }, 1);
+    EXPECT_EQ(total.load(), 100);
+    EXPECT_FALSE(other_ran.load());
+
+    release.set_value();
+    blocker.get();
+    other.get();
+    EXPECT_TRUE(other_ran.load());
+}
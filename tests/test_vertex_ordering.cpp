@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include "../include/graph.h"
+#include "../include/vertex_ordering.h"
+#include "../include/constants.h"
+#include "test_helpers.h"
+
+namespace {
+    const VertexOrdering ALL_ORDERINGS[] = {
+            VertexOrdering::None, VertexOrdering::BFS,
+            VertexOrdering::ReverseCuthillMcKee, VertexOrdering::DegreeSorted
+    };
+
+    // Шлях 0 - 1 - ... - V-1 з перемішаними номерами вершин
+    Graph makeShuffledPath(int V, std::vector<int>& ids) {
+        ids.resize(V);
+        for (int i = 0; i < V; i++) ids[i] = i;
+        std::shuffle(ids.begin(), ids.end(), std::mt19937(3));
+        Graph g(V);
+        for (int i = 0; i + 1 < V; i++) {
+            g.addEdge(ids[i], ids[i + 1], 1.0);
+        }
+        return g;
+    }
+}
+
+TEST(VertexOrderingTest, OrderIsPermutation) {
+    std::vector<int> ids;
+    Graph graph = makeShuffledPath(30, ids);
+    graph.addEdge(ids[5], ids[20], 2.0);
+    for (VertexOrdering ordering : ALL_ORDERINGS) {
+        std::vector<int> order = computeVertexOrder(*graph.getCSR(), ordering);
+        std::sort(order.begin(), order.end());
+        for (int i = 0; i < 30; i++) {
+            EXPECT_EQ(order[i], i) << vertexOrderingName(ordering);
+        }
+    }
+}
+
+TEST(VertexOrderingTest, CuthillMcKeeRestoresPathBandwidth) {
+    std::vector<int> ids;
+    Graph graph = makeShuffledPath(40, ids);
+    std::vector<int> order = computeVertexOrder(*graph.getCSR(), VertexOrdering::ReverseCuthillMcKee);
+    std::vector<int> position(40);
+    for (int i = 0; i < 40; i++) position[order[i]] = i;
+
+    for (int i = 0; i + 1 < 40; i++) {
+        EXPECT_EQ(std::abs(position[ids[i]] - position[ids[i + 1]]), 1);
+    }
+}
+
+TEST(VertexOrderingTest, JohnsonResultDoesNotDependOnOrdering) {
+    Graph graph = makeRandomGraph(40, 11, 120, 3.0);
+    DistanceMatrix expected = expectedMatrix(graph);
+
+    for (VertexOrdering ordering : ALL_ORDERINGS) {
+        graph.setVertexOrdering(ordering);
+        graph.setStrategy(std::make_unique<ParallelDijkstraStrategy>(2));
+        SCOPED_TRACE(vertexOrderingName(ordering));
+        expectSameMatrix(graph.johnson(), expected);
+    }
+}
+
+TEST(VertexOrderingTest, RepeatedJohnsonFollowsEdgeChanges) {
+    std::vector<int> ids;
+    Graph graph = makeShuffledPath(20, ids);
+    graph.setStrategy(std::make_unique<SequentialStrategy>());
+    graph.setVertexOrdering(VertexOrdering::ReverseCuthillMcKee);
+
+    DistanceMatrix first = graph.johnson();
+    DistanceMatrix second = graph.johnson();
+    for (int i = 0; i < 20; i++) {
+        for (int j = 0; j < 20; j++) {
+            EXPECT_EQ(first[i][j], second[i][j]);
+        }
+    }
+    EXPECT_DOUBLE_EQ(second[ids[0]][ids[19]], 19.0);
+
+    // Після зміни ребер переставлена копія будується заново
+    graph.addEdge(ids[0], ids[19], -1.0);
+    DistanceMatrix updated = graph.johnson();
+    EXPECT_DOUBLE_EQ(updated[ids[0]][ids[19]], -1.0);
+    EXPECT_EQ(updated[ids[19]][ids[0]], INF);
+}
+
+TEST(VertexOrderingTest, FloatMatrixIsRestoredInPlace) {
+    std::vector<int> ids;
+    Graph graph = makeShuffledPath(25, ids);
+    graph.addEdge(ids[24], ids[3], 0.5);
+    graph.setStrategy(std::make_unique<SequentialStrategy>());
+    graph.setDistancePrecision(DistancePrecision::Float);
+    DistanceMatrix expected = graph.johnson();
+
+    // Впорядкування з кількома циклами перестановки повертає кожне значення на його місце
+    for (VertexOrdering ordering : ALL_ORDERINGS) {
+        graph.setVertexOrdering(ordering);
+        DistanceMatrix result = graph.johnson();
+        ASSERT_EQ(result.getPrecision(), DistancePrecision::Float);
+        for (int i = 0; i < 25; i++) {
+            for (int j = 0; j < 25; j++) {
+                EXPECT_EQ(result[i][j], expected[i][j]) << vertexOrderingName(ordering);
+            }
+        }
+    }
+}